@@ -0,0 +1,555 @@
+// comp_io_senders.cpp
+/* NOTE: Available since C++20 (no C++26 library support needed) */
+// comp_io.cpp needs C++26 std::execution, which current standard libraries do
+// not ship yet. This file implements the handful of sender/receiver pieces that
+// example uses, with the same spelling, so the same pipeline builds on GCC 12/13:
+//
+//   just, then, let_value, bulk, when_all   - sender factories and adaptors
+//   static_thread_pool / system_thread_pool - a fixed pool with a scheduler
+//   schedule                                - a sender that completes on the pool
+//   this_thread::sync_wait                  - start a pipeline and block for it
+//
+// The design follows P2300 in miniature:
+//   * a sender is a description of work; connect(sender, receiver) produces an
+//     operation state, and start() runs it
+//   * every adaptor's operation state CONTAINS its child's operation state, so
+//     a whole pipeline is one object on the caller's stack; nothing is
+//     allocated per stage (let_value builds its second sender in place)
+//   * schedule's operation state is itself the pool's queue node (intrusive),
+//     so handing work to the pool does not allocate either
+//   * each sender completes with a single value signature, `values`; errors
+//     travel as std::exception_ptr; there is no stop/cancellation channel
+//
+// One difference from comp_io.cpp is deliberate: schedule() completes with NO
+// value (that is also true of std::execution), so the pipeline below produces
+// its first value with then() before let_value receives it.
+//
+//   Build : g++ -std=c++20 -O2 -pthread -o comp_io_senders comp_io_senders.cpp
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mini_exec {
+
+// -- Plumbing -------------------------------------------------------------------
+
+template <class... Ts> struct type_list {};
+
+template <class S> using values_of = typename std::remove_cvref_t<S>::values;
+
+template <class L> struct as_tuple;
+template <class... Ts> struct as_tuple<type_list<Ts...>> { using type = std::tuple<Ts...>; };
+
+template <class... Ls> struct concat { using type = type_list<>; };
+template <class... A> struct concat<type_list<A...>> { using type = type_list<A...>; };
+template <class... A, class... B, class... Rest>
+struct concat<type_list<A...>, type_list<B...>, Rest...> : concat<type_list<A..., B...>, Rest...> {};
+
+// Lets a non-movable operation state be built directly inside an optional or
+// tuple: the conversion returns a prvalue, which is materialised in place.
+template <class Fn>
+struct emplacer {
+  Fn fn;
+  operator std::invoke_result_t<Fn&>() { return fn(); }
+};
+template <class Fn> emplacer(Fn) -> emplacer<Fn>;
+
+template <class S, class R>
+auto connect(S&& s, R r) { return std::forward<S>(s).connect(std::move(r)); }
+
+template <class S, class R>
+using connect_result_t = decltype(mini_exec::connect(std::declval<S>(), std::declval<R>()));
+
+// `sender | adaptor(args)` is `adaptor(sender, args)`.
+template <class Fn>
+struct closure {
+  Fn fn;
+  template <class S> friend auto operator|(S&& s, closure c) { return c.fn(std::forward<S>(s)); }
+};
+template <class Fn> closure(Fn) -> closure<Fn>;
+
+// -- just -------------------------------------------------------------------------
+
+template <class... Ts>
+struct just_sender {
+  using values = type_list<Ts...>;
+  std::tuple<Ts...> vs;
+
+  template <class R>
+  struct op {
+    std::tuple<Ts...> vs;
+    R r;
+    void start() noexcept {
+      std::apply([&](Ts&... v) { std::move(r).set_value(std::move(v)...); }, vs);
+    }
+  };
+  template <class R> op<R> connect(R r) && { return {std::move(vs), std::move(r)}; }
+  template <class R> op<R> connect(R r) const& { return {vs, std::move(r)}; }
+};
+
+template <class... Ts>
+just_sender<std::decay_t<Ts>...> just(Ts&&... vs) { return {{std::forward<Ts>(vs)...}}; }
+
+// -- then -------------------------------------------------------------------------
+
+template <class R, class F>
+struct then_receiver {
+  R r;
+  F f;
+
+  template <class... Vs>
+  void set_value(Vs&&... vs) && noexcept {
+    try {
+      if constexpr (std::is_void_v<std::invoke_result_t<F&, Vs...>>) {
+        std::invoke(f, std::forward<Vs>(vs)...);
+        std::move(r).set_value();
+      } else {
+        std::move(r).set_value(std::invoke(f, std::forward<Vs>(vs)...));
+      }
+    } catch (...) {
+      std::move(r).set_error(std::current_exception());
+    }
+  }
+  void set_error(std::exception_ptr e) && noexcept { std::move(r).set_error(e); }
+};
+
+template <class S, class F>
+struct then_sender {
+  template <class... Vs>
+  static auto result(type_list<Vs...>) {
+    using T = std::invoke_result_t<F&, Vs&&...>;
+    if constexpr (std::is_void_v<T>) return type_list<>{};
+    else return type_list<T>{};
+  }
+  using values = decltype(result(values_of<S>{}));
+
+  S s;
+  F f;
+  template <class R> auto connect(R r) && {
+    return mini_exec::connect(std::move(s), then_receiver<R, F>{std::move(r), std::move(f)});
+  }
+};
+
+template <class F>
+auto then(F f) {
+  return closure{[f = std::move(f)]<class S>(S&& s) {
+    return then_sender<std::decay_t<S>, F>{std::forward<S>(s), f};
+  }};
+}
+
+// -- let_value --------------------------------------------------------------------
+
+template <class S, class F, class R, class L = values_of<S>> struct let_op;
+
+template <class S, class F, class R, class... Vs>
+struct let_op<S, F, R, type_list<Vs...>> {
+  using second_sender = std::invoke_result_t<F&, Vs&...>;
+
+  struct first_receiver {
+    let_op* self;
+    template <class... As> void set_value(As&&... as) && noexcept { self->on_value(std::forward<As>(as)...); }
+    void set_error(std::exception_ptr e) && noexcept { std::move(self->r).set_error(e); }
+  };
+
+  F f;
+  R r;
+  std::optional<std::tuple<Vs...>> vals;                  // Kept alive for the second sender
+  std::optional<connect_result_t<second_sender, R>> second;
+  connect_result_t<S, first_receiver> first;
+
+  let_op(S&& s, F fn, R rcv)
+    : f(std::move(fn)), r(std::move(rcv)),
+      first(mini_exec::connect(std::move(s), first_receiver{this})) {}
+  let_op(const let_op&) = delete;
+
+  void start() noexcept { first.start(); }
+
+  template <class... As>
+  void on_value(As&&... as) noexcept {
+    try {
+      vals.emplace(std::forward<As>(as)...);
+      second.emplace(emplacer{[&] {
+        return mini_exec::connect(std::apply(f, *vals), std::move(r));
+      }});
+    } catch (...) {
+      std::move(r).set_error(std::current_exception());
+      return;
+    }
+    second->start();
+  }
+};
+
+template <class S, class F>
+struct let_value_sender {
+  template <class... Vs>
+  static auto result(type_list<Vs...>) { return values_of<std::invoke_result_t<F&, Vs&...>>{}; }
+  using values = decltype(result(values_of<S>{}));
+
+  S s;
+  F f;
+  template <class R> let_op<S, F, R> connect(R r) && { return {std::move(s), std::move(f), std::move(r)}; }
+};
+
+template <class F>
+auto let_value(F f) {
+  return closure{[f = std::move(f)]<class S>(S&& s) {
+    return let_value_sender<std::decay_t<S>, F>{std::forward<S>(s), f};
+  }};
+}
+
+// -- bulk -------------------------------------------------------------------------
+// Calls f(i, values...) for i in [0, n), then forwards the values unchanged.
+// As in std::execution's default implementation, the calls run sequentially
+// on whichever thread delivered the values.
+
+template <class R, class F>
+struct bulk_receiver {
+  R r;
+  std::size_t n;
+  F f;
+
+  template <class... Vs>
+  void set_value(Vs&&... vs) && noexcept {
+    try {
+      for (std::size_t i = 0; i < n; ++i) std::invoke(f, i, vs...);
+    } catch (...) {
+      std::move(r).set_error(std::current_exception());
+      return;
+    }
+    std::move(r).set_value(std::forward<Vs>(vs)...);
+  }
+  void set_error(std::exception_ptr e) && noexcept { std::move(r).set_error(e); }
+};
+
+template <class S, class F>
+struct bulk_sender {
+  using values = values_of<S>;
+  S s;
+  std::size_t n;
+  F f;
+  template <class R> auto connect(R r) && {
+    return mini_exec::connect(std::move(s), bulk_receiver<R, F>{std::move(r), n, std::move(f)});
+  }
+};
+
+template <class F>
+auto bulk(std::size_t n, F f) {
+  return closure{[n, f = std::move(f)]<class S>(S&& s) {
+    return bulk_sender<std::decay_t<S>, F>{std::forward<S>(s), n, f};
+  }};
+}
+
+// -- when_all ---------------------------------------------------------------------
+// Starts every child, and completes with all of their values concatenated once
+// the last one finishes (or with the first error, once all have finished).
+
+template <class R, class... Ss>
+struct when_all_op {
+  template <std::size_t I>
+  struct child_receiver {
+    when_all_op* self;
+    template <class... Vs> void set_value(Vs&&... vs) && noexcept {
+      std::get<I>(self->results).emplace(std::forward<Vs>(vs)...);
+      self->arrive();
+    }
+    void set_error(std::exception_ptr e) && noexcept {
+      if (!self->failed.exchange(true)) self->error = e;
+      self->arrive();
+    }
+  };
+
+  template <class Seq> struct children;
+  template <std::size_t... I> struct children<std::index_sequence<I...>> {
+    using type = std::tuple<connect_result_t<Ss, child_receiver<I>>...>;
+  };
+
+  R r;
+  std::tuple<std::optional<typename as_tuple<values_of<Ss>>::type>...> results;
+  std::atomic<std::size_t> remaining{sizeof...(Ss)};
+  std::atomic<bool> failed{false};
+  std::exception_ptr error;
+  typename children<std::index_sequence_for<Ss...>>::type ops;
+
+  template <std::size_t... I>
+  when_all_op(R rcv, std::tuple<Ss...>&& ss, std::index_sequence<I...>)
+    : r(std::move(rcv)),
+      ops(emplacer{[&] { return mini_exec::connect(std::move(std::get<I>(ss)), child_receiver<I>{this}); }}...) {}
+  when_all_op(const when_all_op&) = delete;
+
+  void start() noexcept { std::apply([](auto&... op) { (op.start(), ...); }, ops); }
+
+  void arrive() noexcept {
+    if (remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    if (failed.load()) {
+      std::move(r).set_error(error);
+    } else {
+      auto all = std::apply([](auto&... o) { return std::tuple_cat(std::move(*o)...); }, results);
+      std::apply([&](auto&... v) { std::move(r).set_value(std::move(v)...); }, all);
+    }
+  }
+};
+
+template <class... Ss>
+struct when_all_sender {
+  using values = typename concat<values_of<Ss>...>::type;
+  std::tuple<Ss...> ss;
+  template <class R> when_all_op<R, Ss...> connect(R r) && {
+    return {std::move(r), std::move(ss), std::index_sequence_for<Ss...>{}};
+  }
+};
+
+template <class... Ss>
+when_all_sender<std::decay_t<Ss>...> when_all(Ss&&... ss) { return {{std::forward<Ss>(ss)...}}; }
+
+// -- static_thread_pool and schedule ------------------------------------------------
+
+// The queue node. schedule()'s operation state derives from it, so enqueueing
+// links the operation itself into the queue.
+struct task_base {
+  task_base* next = nullptr;
+  void (*execute)(task_base*) noexcept = nullptr;
+};
+
+class static_thread_pool {
+public:
+  explicit static_thread_pool(unsigned n = std::thread::hardware_concurrency()) {
+    for (unsigned i = 0; i < std::max(1u, n); ++i) workers_.emplace_back([this] { run(); });
+  }
+  ~static_thread_pool() {
+    { std::lock_guard lock(m_); stop_ = true; }
+    cv_.notify_all();
+    for (auto& w : workers_) w.join();
+  }
+
+  void enqueue(task_base* t) {
+    {
+      std::lock_guard lock(m_);
+      t->next = nullptr;
+      (tail_ ? tail_->next : head_) = t;
+      tail_ = t;
+    }
+    cv_.notify_one();
+  }
+
+  class scheduler;
+  scheduler get_scheduler();
+
+private:
+  void run() {
+    for (;;) {
+      task_base* t;
+      {
+        std::unique_lock lock(m_);
+        cv_.wait(lock, [&] { return stop_ || head_; });
+        if (!head_) return;
+        t = head_;
+        head_ = head_->next;
+        if (!head_) tail_ = nullptr;
+      }
+      t->execute(t);
+    }
+  }
+
+  std::mutex m_;
+  std::condition_variable cv_;
+  task_base* head_ = nullptr;
+  task_base* tail_ = nullptr;
+  bool stop_ = false;
+  std::vector<std::thread> workers_;
+};
+
+class static_thread_pool::scheduler {
+public:
+  struct sender {
+    using values = type_list<>;
+    static_thread_pool* pool;
+
+    template <class R>
+    struct op : task_base {
+      static_thread_pool* pool;
+      R r;
+      op(static_thread_pool* p, R rcv) : pool(p), r(std::move(rcv)) {
+        execute = [](task_base* t) noexcept { std::move(static_cast<op*>(t)->r).set_value(); };
+      }
+      op(const op&) = delete;
+      void start() noexcept { pool->enqueue(this); }
+    };
+    template <class R> op<R> connect(R r) const { return {pool, std::move(r)}; }
+  };
+
+  explicit scheduler(static_thread_pool* p) : pool_(p) {}
+  sender schedule() const { return {pool_}; }
+
+private:
+  static_thread_pool* pool_;
+};
+
+inline static_thread_pool::scheduler static_thread_pool::get_scheduler() { return scheduler(this); }
+
+// A handle to one process-wide pool, spelled like std::execution's.
+struct system_thread_pool {
+  static_thread_pool::scheduler get_scheduler() const {
+    static static_thread_pool pool;
+    return pool.get_scheduler();
+  }
+};
+
+template <class Sch>
+auto schedule(const Sch& sch) { return sch.schedule(); }
+
+// -- sync_wait ----------------------------------------------------------------------
+
+template <class T>
+struct sync_wait_state {
+  std::mutex m;
+  std::condition_variable cv;
+  bool done = false;
+  std::optional<T> value;
+  std::exception_ptr error;
+};
+
+template <class T>
+struct sync_wait_receiver {
+  sync_wait_state<T>* st;
+  // Notify under the lock: st lives on sync_wait's stack, and once the
+  // waiter can see done it may return and destroy st.
+  void finish() noexcept {
+    std::lock_guard lock(st->m);
+    st->done = true;
+    st->cv.notify_one();
+  }
+  template <class... Vs> void set_value(Vs&&... vs) && noexcept {
+    st->value.emplace(std::forward<Vs>(vs)...);
+    finish();
+  }
+  void set_error(std::exception_ptr e) && noexcept { st->error = e; finish(); }
+};
+
+namespace this_thread {
+
+// Senders are consumed by connect, so an lvalue pipeline is copied first and
+// can be waited on again.
+template <class S>
+auto sync_wait(S&& s) {
+  using result_t = typename as_tuple<values_of<S>>::type;
+  sync_wait_state<result_t> st;
+  auto op = mini_exec::connect(std::decay_t<S>(std::forward<S>(s)), sync_wait_receiver<result_t>{&st});
+  op.start();
+  std::unique_lock lock(st.m);
+  st.cv.wait(lock, [&] { return st.done; });
+  if (st.error) std::rethrow_exception(st.error);
+  return std::move(st.value);
+}
+
+} // namespace this_thread
+} // namespace mini_exec
+
+// Counts every allocation in the program, to check the "nothing per stage" claim.
+static std::atomic<std::size_t> g_news{0};
+void* operator new(std::size_t n)
+{
+  ++g_news;
+  if (void* p = std::malloc(n ? n : 1)) return p;
+  throw std::bad_alloc();
+}
+// GCC pairs the inlined malloc with `delete` and warns; the pairing is correct.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#pragma GCC diagnostic pop
+
+using namespace mini_exec;
+int main()
+{
+  // Create a scheduler (system thread pool)
+  auto sched = system_thread_pool{}.get_scheduler();
+
+  // Build a pipeline
+  auto s =  schedule(sched) // Start work on the scheduler
+          | then([] { return 1; }) // schedule() sends no value, so produce the first one
+          | let_value([](int x) { // let_value: chain a new sender based on result
+            std::cout << "Step 2: got " << x << "\n";  // Return a new sender that does more work
+            return just(x + 1);
+          })
+          | then([](int y) { // then: final transformation
+            std::cout << "Step 3: final value " << y << "\n";
+            return y * 2;
+          });
+
+  // Run synchronously
+  auto result = this_thread::sync_wait(s);
+  std::cout << "sync_wait result: " << std::get<0>(*result) << "\n";
+
+  // when_all and bulk
+  auto [a, b] = *this_thread::sync_wait(when_all(
+      schedule(sched) | then([] { return 20; }),
+      schedule(sched) | then([] { return 22.5; })));
+  std::cout << "when_all: " << a << " + " << b << " = " << a + b << "\n";
+
+  auto [squares] = *this_thread::sync_wait(
+      just(std::vector<int>{1, 2, 3, 4})
+      | bulk(4, [](std::size_t i, std::vector<int>& v) { v[i] *= v[i]; }));
+  std::cout << "bulk:";
+  for (int v : squares) std::cout << " " << v;
+  std::cout << "\n";
+
+  // Errors thrown in any stage come out of sync_wait.
+  try {
+    this_thread::sync_wait(schedule(sched) | then([]() -> int { throw std::runtime_error("boom"); }));
+  } catch (const std::runtime_error& e) {
+    std::cout << "error propagated: " << e.what() << "\n";
+  }
+
+  // Latency of a three-stage hop through the pool, versus the same chain
+  // written with std::async (one new thread and one shared state per stage).
+  auto pipeline = [&] {
+    return schedule(sched)
+         | then([] { return 1; })
+         | let_value([](int x) { return just(x + 1); })
+         | then([](int y) { return y * 2; });
+  };
+  auto async_chain = [] {
+    auto f1 = std::async(std::launch::async, [] { return 1; });
+    auto f2 = std::async(std::launch::async, [x = f1.get()] { return x + 1; });
+    auto f3 = std::async(std::launch::async, [y = f2.get()] { return y * 2; });
+    return f3.get();
+  };
+
+  using clock = std::chrono::steady_clock;
+  const int runs = 5000;
+  long long check = 0;
+
+  std::size_t news_before = g_news;
+  auto t0 = clock::now();
+  for (int i = 0; i < runs; ++i) check += std::get<0>(*this_thread::sync_wait(pipeline()));
+  double senders_us = std::chrono::duration<double, std::micro>(clock::now() - t0).count() / runs;
+  double senders_allocs = double(g_news - news_before) / runs;
+
+  news_before = g_news;
+  t0 = clock::now();
+  for (int i = 0; i < runs; ++i) check += async_chain();
+  double async_us = std::chrono::duration<double, std::micro>(clock::now() - t0).count() / runs;
+  double async_allocs = double(g_news - news_before) / runs;
+
+  std::cout << "\nlatency per run (" << runs << " runs, check " << check << ")\n";
+  std::cout << "  senders on static_thread_pool: " << senders_us << " us, "
+            << senders_allocs << " allocations\n";
+  std::cout << "  std::async chain             : " << async_us << " us, "
+            << async_allocs << " allocations\n";
+
+  return 0;
+}
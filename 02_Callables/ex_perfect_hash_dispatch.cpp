@@ -0,0 +1,195 @@
+// ===========================================================================
+// A constexpr perfect-hash dispatch table   — name -> function pointer in O(1)
+//
+//   Build : g++ -std=c++20 -O2 -Wall -Wextra -o ph_dispatch ex_perfect_hash_dispatch.cpp
+//
+// Step 2 of try_08.cpp stores operations in a std::map<std::string, BinOp>
+// and run(table, name, a, b) looks the name up on every call: a walk down a
+// red-black tree with a string compare at each node, after the caller has
+// built a std::string for the key. For a calculator that dispatches every
+// operator token, that lookup is most of the work.
+//
+// The set of operator names is known when the program is compiled, so the
+// table can be built then too. perfect_dispatch<N> is:
+//   * a fixed array of M = bit_ceil(2N) slots, each holding a name and a BinOp
+//   * a seeded FNV-1a hash; the constructor tries seeds until every name lands
+//     in its own slot, so lookup is one hash, one mask, one string compare
+//   * usable as a constexpr variable: the seed search happens in the compiler,
+//     a failed search (or a duplicate name) is a compile error, and the table
+//     lives in read-only data with no allocation at any point
+//   * keyed by std::string_view, so a token sliced out of the input line is
+//     looked up without building a std::string
+//
+// find(name) returns nullptr for an unknown name rather than throwing, like a
+// failed map::find; run() mirrors try_08's signature.
+// ===========================================================================
+#include <array>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using BinOp = int (*)(int, int);
+
+// -- The operations ----------------------------------------------------------
+inline int add(int a, int b) { return a + b; }
+inline int sub(int a, int b) { return a - b; }
+inline int mul(int a, int b) { return a * b; }
+inline int div_(int a, int b) { return b ? a / b : 0; }
+inline int mod(int a, int b) { return b ? a % b : 0; }
+inline int min_(int a, int b) { return a < b ? a : b; }
+inline int max_(int a, int b) { return a < b ? b : a; }
+inline int band(int a, int b) { return a & b; }
+inline int bor(int a, int b) { return a | b; }
+inline int bxor(int a, int b) { return a ^ b; }
+inline int shl(int a, int b) { return int(unsigned(a) << (unsigned(b) & 31)); }
+inline int shr(int a, int b) { return a >> (b & 31); }
+
+// -- The table ---------------------------------------------------------------
+template <std::size_t N>
+class perfect_dispatch {
+public:
+    struct entry {
+        std::string_view name{};
+        BinOp fn = nullptr;
+    };
+
+    static constexpr std::size_t slots = std::bit_ceil(2 * N);
+
+    consteval explicit perfect_dispatch(const entry (&entries)[N]) {
+        for (std::size_t i = 0; i < N; ++i)
+            for (std::size_t j = i + 1; j < N; ++j)
+                if (entries[i].name == entries[j].name) throw std::logic_error("duplicate operator name");
+
+        for (std::uint32_t seed = 0; seed < 100'000; ++seed) {
+            std::array<entry, slots> t{};
+            bool collision = false;
+            for (std::size_t i = 0; i < N && !collision; ++i) {
+                entry& slot = t[hash(entries[i].name, seed) & (slots - 1)];
+                collision = slot.fn != nullptr;
+                slot = entries[i];
+            }
+            if (!collision) {
+                table_ = t;
+                seed_ = seed;
+                return;
+            }
+        }
+        throw std::logic_error("no perfect hash seed found");
+    }
+
+    // One hash, one mask, one compare. Empty slots have an empty name and a
+    // null fn, so a miss needs no separate "occupied" test; the length check
+    // rejects most misses before touching the characters.
+    constexpr BinOp find(std::string_view name) const {
+        const entry& e = table_[hash(name, seed_) & (slots - 1)];
+        return e.name.size() == name.size() && e.name == name ? e.fn : nullptr;
+    }
+    constexpr bool contains(std::string_view name) const { return find(name) != nullptr; }
+    constexpr std::size_t size() const { return N; }
+    constexpr std::uint32_t seed() const { return seed_; }
+
+private:
+    static constexpr std::uint32_t hash(std::string_view s, std::uint32_t seed) {
+        std::uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+        for (char c : s) h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+        return h ^ (h >> 15);
+    }
+
+    std::array<entry, slots> table_{};
+    std::uint32_t seed_ = 0;
+};
+
+template <std::size_t N>
+int run(const perfect_dispatch<N>& table, std::string_view name, int a, int b) {
+    BinOp f = table.find(name);
+    if (!f) throw std::out_of_range("unknown operator");
+    return f(a, b);
+}
+
+// The calculator's operators, hashed by the compiler.
+constexpr perfect_dispatch<12> operators({
+    {"add", add}, {"sub", sub}, {"mul", mul}, {"div", div_}, {"mod", mod}, {"min", min_},
+    {"max", max_}, {"and", band}, {"or", bor}, {"xor", bxor}, {"shl", shl}, {"shr", shr},
+});
+
+static_assert(operators.find("mul") == &mul && operators.find("shr") == &shr);
+static_assert(operators.find("pow") == nullptr && operators.find("ad") == nullptr);
+
+// -- The tables try_08.cpp would build ---------------------------------------
+int run(const std::map<std::string, BinOp>& table, const std::string& name, int a, int b) {
+    return table.find(name)->second(a, b);
+}
+int run(const std::map<std::string, BinOp, std::less<>>& table, std::string_view name, int a, int b) {
+    return table.find(name)->second(a, b);
+}
+int run(const std::unordered_map<std::string, BinOp>& table, const std::string& name, int a, int b) {
+    return table.find(name)->second(a, b);
+}
+
+int main() {
+    std::cout << "perfect_dispatch<" << operators.size() << ">: " << operators.slots
+              << " slots, seed " << operators.seed() << ", " << sizeof(operators) << " bytes\n";
+
+    assert(run(operators, "sub", 10, 3) == 7);
+    assert(run(operators, "mul", 6, 7) == 42);
+    std::string token = "max(4,9)";
+    assert(run(operators, std::string_view(token).substr(0, 3), 4, 9) == 9);   // no std::string made
+    bool threw = false;
+    try { run(operators, "pow", 2, 3); } catch (const std::out_of_range&) { threw = true; }
+    assert(threw && !operators.contains(""));
+
+    // -- Benchmark: dispatch a stream of operator tokens ---------------------
+    constexpr std::pair<const char*, BinOp> ops[] = {
+        {"add", add}, {"sub", sub}, {"mul", mul}, {"div", div_}, {"mod", mod}, {"min", min_},
+        {"max", max_}, {"and", band}, {"or", bor}, {"xor", bxor}, {"shl", shl}, {"shr", shr},
+    };
+    std::map<std::string, BinOp> tree;
+    std::map<std::string, BinOp, std::less<>> tree_sv;
+    std::unordered_map<std::string, BinOp> hashed;
+    for (auto [name, fn] : ops) {
+        tree.emplace(name, fn);
+        tree_sv.emplace(name, fn);
+        hashed.emplace(name, fn);
+    }
+
+    const std::size_t calls = 20'000'000;
+    std::mt19937 gen(8);
+    std::uniform_int_distribution<std::size_t> pick(0, std::size(ops) - 1);
+    std::vector<std::string> tokens(4096);
+    for (auto& t : tokens) t = ops[pick(gen)].first;
+
+    using clock = std::chrono::steady_clock;
+    auto bench = [&](const char* label, auto&& call) {
+        auto t0 = clock::now();
+        long long acc = 0;
+        for (std::size_t i = 0; i < calls; ++i) acc += call(tokens[i & 4095], int(i & 1023), 7);
+        double ms = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+        std::cout << "  " << label << ms << " ms  (" << ms * 1e6 / double(calls) << " ns/call)\n";
+        return acc;
+    };
+
+    std::cout << calls << " dispatches over " << std::size(ops) << " operators\n";
+    long long r_map = bench("std::map<std::string>           : ",
+                            [&](const std::string& s, int a, int b) { return run(tree, s, a, b); });
+    long long r_sv  = bench("std::map<std::string, less<>>   : ",
+                            [&](std::string_view s, int a, int b) { return run(tree_sv, s, a, b); });
+    long long r_um  = bench("std::unordered_map<std::string> : ",
+                            [&](const std::string& s, int a, int b) { return run(hashed, s, a, b); });
+    long long r_ph  = bench("constexpr perfect_dispatch      : ",
+                            [&](std::string_view s, int a, int b) { return run(operators, s, a, b); });
+
+    const bool ok = r_map == r_sv && r_sv == r_um && r_um == r_ph;
+    std::cout << (ok ? "all tables agree\n" : "RESULTS DIFFER\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,294 @@
+// ===========================================================================
+// A small-buffer-optimised copyable_function   — no heap for small targets
+//
+//   Build : g++ -std=c++23 -O2 -Wall -Wextra -o sbo_fn ex_sbo_copyable_fn.cpp
+//
+// The copyable_function stand-in in try_07.cpp is the textbook shape: a
+// virtual Base with call() and clone(), and a heap-allocated Impl<F> made with
+// std::make_unique on EVERY construction and EVERY copy. It is easy to read,
+// but a table of a million small lambdas then means a million allocations, and
+// copying the table means a million more.
+//
+// sbo_copyable_function<R(Args...), N> keeps the same interface and changes
+// the storage:
+//   * an inline buffer of N pointers (default 3 = 24 bytes on 64-bit); any
+//     target that fits, is at most pointer-aligned and is nothrow-movable
+//     lives inside the wrapper
+//   * larger targets are still heap-allocated, and the buffer holds the pointer
+//   * dispatch goes through a hand-rolled, per-type static table of function
+//     pointers (call / copy / relocate / destroy), so there is one indirect call
+//     and no virtual base
+//   * trivially copyable targets (and every heap-stored target, which is just a
+//     pointer) get null copy/relocate/destroy entries, meaning "memcpy the
+//     buffer" — so moving, copying and destroying them involves no call at all
+//   * sbo_stats counts inline stores and heap allocations, so the claim
+//     "no allocation" can be checked rather than trusted
+//
+// Calling an empty wrapper throws std::bad_function_call (like std::function,
+// unlike the UB of the standard copyable_function); the empty state is a table
+// whose call entry throws, so the call path needs no branch.
+// ===========================================================================
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// -- Allocation counters -----------------------------------------------------
+struct sbo_stats {
+    static inline std::atomic<std::size_t> inline_stores{0};
+    static inline std::atomic<std::size_t> heap_allocations{0};
+
+    static void reset() { inline_stores = 0; heap_allocations = 0; }
+};
+
+template <class Sig, std::size_t InlinePtrs = 3> class sbo_copyable_function;
+
+template <class R, class... Args, std::size_t InlinePtrs>
+class sbo_copyable_function<R(Args...), InlinePtrs> {
+    static constexpr std::size_t kSize  = InlinePtrs * sizeof(void*);
+    static constexpr std::size_t kAlign = alignof(void*);
+
+    struct Storage { alignas(kAlign) unsigned char bytes[kSize < sizeof(void*) ? sizeof(void*) : kSize]; };
+
+    // One of these exists per stored type. A null copy/relocate/destroy means
+    // the operation is a plain memcpy of the buffer (or nothing, for destroy).
+    struct VTable {
+        R    (*call)(Storage&, Args&&...);
+        void (*copy)(Storage& dst, const Storage& src);
+        void (*relocate)(Storage& dst, Storage& src) noexcept;   // move-construct, then destroy src
+        void (*destroy)(Storage&) noexcept;
+        bool on_heap;
+    };
+
+    template <class F>
+    static constexpr bool fits_inline = sizeof(F) <= sizeof(Storage) && alignof(F) <= kAlign
+                                     && std::is_nothrow_move_constructible_v<F>;
+
+    template <class F> static F* inline_ptr(Storage& s) { return std::launder(reinterpret_cast<F*>(s.bytes)); }
+    template <class F> static const F* inline_ptr(const Storage& s) { return std::launder(reinterpret_cast<const F*>(s.bytes)); }
+    template <class F> static F*& heap_ptr(Storage& s) { return *std::launder(reinterpret_cast<F**>(s.bytes)); }
+    template <class F> static F* heap_ptr(const Storage& s) { return *std::launder(reinterpret_cast<F* const*>(s.bytes)); }
+
+    template <class F>
+    static constexpr VTable inline_table{
+        [](Storage& s, Args&&... a) -> R { return std::invoke(*inline_ptr<F>(s), std::forward<Args>(a)...); },
+        std::is_trivially_copyable_v<F> ? nullptr
+            : +[](Storage& d, const Storage& s) { ::new (d.bytes) F(*inline_ptr<F>(s)); },
+        std::is_trivially_copyable_v<F> ? nullptr
+            : +[](Storage& d, Storage& s) noexcept {
+                  ::new (d.bytes) F(std::move(*inline_ptr<F>(s)));
+                  inline_ptr<F>(s)->~F();
+              },
+        std::is_trivially_destructible_v<F> ? nullptr
+            : +[](Storage& s) noexcept { inline_ptr<F>(s)->~F(); },
+        false,
+    };
+
+    // The buffer holds only a pointer, so relocation is always a memcpy.
+    template <class F>
+    static constexpr VTable heap_table{
+        [](Storage& s, Args&&... a) -> R { return std::invoke(*heap_ptr<F>(s), std::forward<Args>(a)...); },
+        [](Storage& d, const Storage& s) {
+            ::new (d.bytes) F*(new F(*heap_ptr<F>(s)));
+            ++sbo_stats::heap_allocations;
+        },
+        nullptr,
+        [](Storage& s) noexcept { delete heap_ptr<F>(s); },
+        true,
+    };
+
+    static constexpr VTable empty_table{
+        [](Storage&, Args&&...) -> R { throw std::bad_function_call(); },
+        nullptr, nullptr, nullptr, false,
+    };
+
+    Storage storage_;
+    const VTable* vt_ = &empty_table;
+
+    void copy_from(const sbo_copyable_function& o) {
+        if (o.vt_->copy) o.vt_->copy(storage_, o.storage_);
+        else std::memcpy(&storage_, &o.storage_, sizeof(Storage));
+        vt_ = o.vt_;
+        if (*this && !vt_->on_heap) ++sbo_stats::inline_stores;
+    }
+
+    void move_from(sbo_copyable_function& o) noexcept {
+        if (o.vt_->relocate) o.vt_->relocate(storage_, o.storage_);
+        else std::memcpy(&storage_, &o.storage_, sizeof(Storage));
+        vt_ = std::exchange(o.vt_, &empty_table);
+    }
+
+    void reset() noexcept {
+        if (vt_->destroy) vt_->destroy(storage_);
+        vt_ = &empty_table;
+    }
+
+public:
+    static constexpr std::size_t inline_capacity = sizeof(Storage);
+
+    sbo_copyable_function() noexcept = default;
+
+    template <class F, class D = std::decay_t<F>,
+              class = std::enable_if_t<!std::is_same_v<D, sbo_copyable_function> &&
+                                       std::is_copy_constructible_v<D> &&
+                                       std::is_invocable_r_v<R, D&, Args...>>>
+    sbo_copyable_function(F&& f) {
+        if constexpr (fits_inline<D>) {
+            ::new (storage_.bytes) D(std::forward<F>(f));
+            vt_ = &inline_table<D>;
+            ++sbo_stats::inline_stores;
+        } else {
+            ::new (storage_.bytes) D*(new D(std::forward<F>(f)));
+            vt_ = &heap_table<D>;
+            ++sbo_stats::heap_allocations;
+        }
+    }
+
+    sbo_copyable_function(const sbo_copyable_function& o) { copy_from(o); }
+    sbo_copyable_function(sbo_copyable_function&& o) noexcept { move_from(o); }
+
+    sbo_copyable_function& operator=(const sbo_copyable_function& o) {
+        if (this != &o) {
+            sbo_copyable_function tmp(o);                // Strong guarantee if copy throws
+            reset();
+            move_from(tmp);
+        }
+        return *this;
+    }
+    sbo_copyable_function& operator=(sbo_copyable_function&& o) noexcept {
+        if (this != &o) { reset(); move_from(o); }
+        return *this;
+    }
+
+    ~sbo_copyable_function() { reset(); }
+
+    explicit operator bool() const noexcept { return vt_ != &empty_table; }
+    bool is_inline() const noexcept { return *this && !vt_->on_heap; }
+
+    R operator()(Args... a) const {
+        return vt_->call(const_cast<Storage&>(storage_), std::forward<Args>(a)...);
+    }
+};
+
+// -- Counting every allocation in the program --------------------------------
+// Replacing the global operator new lets the benchmark count std::function's
+// allocations too, without any cooperation from the library.
+static std::atomic<std::size_t> g_news{0};
+void* operator new(std::size_t n) {
+    ++g_news;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+int times3(int x) { return x * 3; }
+
+template <class Fn>
+void bench(const char* name, std::size_t n) {
+    using clock = std::chrono::steady_clock;
+    auto ms = [](auto t0) { return std::chrono::duration<double, std::milli>(clock::now() - t0).count(); };
+
+    // A typical callback: three words of captured state, trivially copyable.
+    std::vector<Fn> table;
+    table.reserve(n);
+    std::size_t before = g_news;
+
+    auto t0 = clock::now();
+    for (std::size_t i = 0; i < n; ++i) {
+        const int* base = nullptr;
+        std::size_t scale = i & 7, offset = i;
+        table.emplace_back([base, scale, offset](int x) { return int(x * scale + offset) + (base != nullptr); });
+    }
+    double build = ms(t0);
+    std::size_t build_allocs = g_news - before;
+
+    before = g_news;
+    t0 = clock::now();
+    std::vector<Fn> copy = table;
+    double dup = ms(t0);
+    std::size_t copy_allocs = g_news - before - 1;      // minus the vector's own buffer
+
+    t0 = clock::now();
+    long long sum = 0;
+    for (int r = 0; r < 4; ++r)
+        for (const Fn& f : copy) sum += f(r);
+    double call = ms(t0);
+
+    std::cout << "   " << name << ": build " << build << " ms (" << build_allocs << " allocs), copy "
+              << dup << " ms (" << copy_allocs << " allocs), 4x call " << call << " ms  [" << sum % 1000 << "]\n";
+}
+
+int main() {
+    using fn = sbo_copyable_function<int(int)>;
+    std::cout << std::boolalpha;
+
+    // -- 1. Small targets live inline ---------------------------------------
+    {
+        sbo_stats::reset();
+        int k = 10;
+        fn f = [k](int x) { return x + k; };
+        fn g = f;                                        // copy: memcpy, no allocation
+        fn h = std::move(g);                             // relocate: memcpy
+        assert(f(1) == 11 && h(2) == 12 && !g && h.is_inline());
+        std::cout << "1. inline capacity         : " << fn::inline_capacity << " bytes, "
+                  << sbo_stats::inline_stores << " inline stores, "
+                  << sbo_stats::heap_allocations << " heap allocations\n";
+        assert(sbo_stats::heap_allocations == 0);
+    }
+
+    // -- 2. Function pointers and non-trivial targets -----------------------
+    {
+        sbo_stats::reset();
+        fn p = times3;
+        std::string tag = "x";                           // std::string is not trivially copyable,
+        sbo_copyable_function<int(int), 6> s = [tag](int x) { return x + int(tag.size()); };  // but fits 6 words
+        auto s2 = s;
+        assert(p(14) == 42 && s2(1) == 2);
+        std::cout << "2. pointer + string capture: " << sbo_stats::heap_allocations << " heap allocations\n";
+        assert(sbo_stats::heap_allocations == 0);
+    }
+
+    // -- 3. Large targets fall back to the heap, copies stay independent ----
+    {
+        sbo_stats::reset();
+        int total = 0;
+        struct Big { long pad[8]; int* out; void operator()() const { ++*out; } };
+        sbo_copyable_function<void()> f = Big{{}, &total};
+        auto g = f;
+        f(); g(); g();
+        assert(!g.is_inline());
+        std::cout << "3. oversized target        : " << sbo_stats::heap_allocations
+                  << " heap allocations (construct + copy), total=" << total << "\n";
+        assert(sbo_stats::heap_allocations == 2 && total == 3);
+    }
+
+    // -- 4. Empty wrappers throw, like std::function ------------------------
+    {
+        fn empty;
+        bool threw = false;
+        try { empty(1); } catch (const std::bad_function_call&) { threw = true; }
+        std::cout << "4. empty call threw        : " << threw << "\n";
+        assert(threw);
+    }
+
+    // -- 5. A million-entry callback table ----------------------------------
+    {
+        const std::size_t n = 1'000'000;
+        std::cout << "5. " << n << " callbacks capturing 24 bytes\n";
+        bench<std::function<int(int)>>("std::function        ", n);
+        bench<fn>("sbo_copyable_function", n);
+    }
+
+    std::cout << "\ndone\n";
+}
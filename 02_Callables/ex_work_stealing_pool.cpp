@@ -0,0 +1,435 @@
+// ===========================================================================
+// A work-stealing thread pool built on std::packaged_task
+//
+//   Build : g++ -std=c++23 -O2 -pthread -o pool ex_work_stealing_pool.cpp
+//
+// Section 7 of ex_std_packaged_task.cpp launches one std::thread per task.
+// That is fine for four tasks, but creating and joining a kernel thread costs
+// tens of microseconds, so at a few thousand tasks per second the program
+// spends its time managing threads rather than running tasks.
+//
+// This file keeps packaged_task as the result plumbing and replaces the
+// thread-per-task launch with a fixed set of workers:
+//   * every worker owns a Chase-Lev deque: it pushes and pops at the bottom
+//     without locks, while idle workers steal from the top with one CAS
+//   * tasks submitted from outside the pool go to a shared injection queue;
+//     tasks submitted from inside a running task go to that worker's own deque
+//   * an idle worker looks at its deque, then the injection queue, then steals,
+//     and only then sleeps on a condition variable
+//
+// Interface
+//   * submit(f, args...)  -> std::future<R>, as packaged_task::get_future()
+//   * submit_bulk(n, f)   -> one future per f(i), enqueued under a single lock
+//   * wait_all()          -> returns once every submitted task has finished;
+//                            the caller helps run tasks while it waits. Not
+//                            for use inside one of the pool's tasks: the
+//                            caller would be waiting for itself (asserted)
+// ===========================================================================
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// A unit of work: a packaged_task with its arguments already bound, erased to
+// void(). Deques hold pointers to these, so moving one between threads is a
+// single word.
+using Job = std::move_only_function<void()>;
+
+// -- Chase-Lev work-stealing deque --------------------------------------------
+// Lê, Pop, Cohen, Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak
+// Memory Models" (PPoPP 2013). The owner calls push()/pop(); any thread may
+// call steal(). Arrays replaced by a resize are kept until the deque is
+// destroyed, because a thief may still be reading from one.
+class ChaseLevDeque {
+    struct Array {
+        std::int64_t mask;
+        std::unique_ptr<std::atomic<Job*>[]> slots;
+
+        explicit Array(std::int64_t capacity)
+            : mask(capacity - 1), slots(new std::atomic<Job*>[capacity]) {}
+        std::int64_t capacity() const { return mask + 1; }
+        Job* get(std::int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+        void put(std::int64_t i, Job* j) { slots[i & mask].store(j, std::memory_order_relaxed); }
+    };
+
+    alignas(64) std::atomic<std::int64_t> top_{0};
+    alignas(64) std::atomic<std::int64_t> bottom_{0};
+    alignas(64) std::atomic<Array*> array_;
+    std::vector<std::unique_ptr<Array>> arrays_;   // Owner-only: current + retired
+
+public:
+    explicit ChaseLevDeque(std::int64_t capacity = 256) {
+        arrays_.push_back(std::make_unique<Array>(capacity));
+        array_.store(arrays_.back().get(), std::memory_order_relaxed);
+    }
+
+    ~ChaseLevDeque() {
+        while (Job* j = pop()) delete j;
+    }
+
+    void push(Job* job) {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        Array* a = array_.load(std::memory_order_relaxed);
+        if (b - t > a->capacity() - 1) {
+            auto bigger = std::make_unique<Array>(a->capacity() * 2);
+            for (std::int64_t i = t; i < b; ++i) bigger->put(i, a->get(i));
+            a = bigger.get();
+            arrays_.push_back(std::move(bigger));
+            array_.store(a, std::memory_order_release);
+        }
+        a->put(b, job);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    Job* pop() {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Array* a = array_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+
+        Job* job = nullptr;
+        if (t <= b) {
+            job = a->get(b);
+            if (t == b) {
+                // The last element: race any thief for it.
+                if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed))
+                    job = nullptr;
+                bottom_.store(b + 1, std::memory_order_relaxed);
+            }
+        } else {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    Job* steal() {
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) return nullptr;
+
+        Job* job = array_.load(std::memory_order_acquire)->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed))
+            return nullptr;                            // Lost the race; try elsewhere
+        return job;
+    }
+};
+
+// -- The pool -----------------------------------------------------------------
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(unsigned workers = std::thread::hardware_concurrency())
+        : deques_(std::max(1u, workers)) {
+        for (unsigned i = 0; i < deques_.size(); ++i) threads_.emplace_back([this, i] { run(i); });
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool() {
+        wait_all();
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : threads_) t.join();
+    }
+
+    template <class F, class... Args>
+    auto submit(F&& f, Args&&... args) {
+        using R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+        std::packaged_task<R()> task(
+            // One-shot: the stored f and arguments are moved into the call.
+            [f = std::forward<F>(f), ... a = std::forward<Args>(args)]() mutable {
+                return std::invoke(std::move(f), std::move(a)...);
+            });
+        std::future<R> fut = task.get_future();
+        enqueue(new Job(std::move(task)));
+        return fut;
+    }
+
+    // Submits f(0), f(1), ..., f(n - 1). External callers take the injection
+    // lock once for the whole batch instead of once per task.
+    template <class F>
+    auto submit_bulk(std::size_t n, F f) {
+        using R = std::invoke_result_t<F&, std::size_t>;
+        std::vector<std::future<R>> futures;
+        std::vector<Job*> jobs;
+        futures.reserve(n);
+        jobs.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            std::packaged_task<R()> task([f, i]() mutable { return f(i); });
+            futures.push_back(task.get_future());
+            jobs.push_back(new Job(std::move(task)));
+        }
+        in_flight_.fetch_add(n, std::memory_order_relaxed);
+        if (current_pool == this) {
+            for (Job* j : jobs) deques_[current_worker].push(j);
+        } else {
+            std::lock_guard lock(mutex_);
+            injected_.insert(injected_.end(), jobs.begin(), jobs.end());
+        }
+        pending_.fetch_add(n);
+        { std::lock_guard lock(mutex_); }
+        wake_.notify_all();
+        return futures;
+    }
+
+    // Blocks until every task submitted so far (and every task those tasks
+    // submit) has finished. The caller runs tasks itself while it waits.
+    void wait_all() {
+        assert(!running_here() && "wait_all() inside a task of the same pool never returns");
+        while (in_flight_.load(std::memory_order_acquire) != 0) {
+            if (Job* j = find_work(current_pool == this ? current_worker : deques_.size()))
+                execute(j);
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    std::size_t size() const { return threads_.size(); }
+
+private:
+    static thread_local WorkStealingPool* current_pool;
+    static thread_local std::size_t current_worker;
+
+    // The tasks executing on this thread, innermost first. More than one when
+    // a task runs others through wait_all(), possibly of another pool.
+    struct frame { const WorkStealingPool* pool; const frame* outer; };
+    static thread_local const frame* running_;
+
+    bool running_here() const {
+        for (const frame* f = running_; f; f = f->outer)
+            if (f->pool == this) return true;
+        return false;
+    }
+
+    void enqueue(Job* job) {
+        in_flight_.fetch_add(1, std::memory_order_relaxed);
+        if (current_pool == this) {
+            deques_[current_worker].push(job);         // Lock-free fast path
+        } else {
+            std::lock_guard lock(mutex_);
+            injected_.push_back(job);
+        }
+        pending_.fetch_add(1);
+        if (sleepers_.load() != 0) {
+            // Taking the lock orders this notify after any sleeper's predicate
+            // check, so a worker about to block cannot miss it.
+            { std::lock_guard lock(mutex_); }
+            wake_.notify_one();
+        }
+    }
+
+    // Own deque first (LIFO, cache-warm), then the shared queue, then the other
+    // deques starting at a random victim. `self` == deques_.size() means the
+    // caller is not a worker of this pool.
+    Job* find_work(std::size_t self) {
+        if (self < deques_.size())
+            if (Job* j = deques_[self].pop()) return taken(j);
+        {
+            std::unique_lock lock(mutex_, std::try_to_lock);
+            if (lock && !injected_.empty()) {
+                Job* j = injected_.front();
+                injected_.pop_front();
+                return taken(j);
+            }
+        }
+        thread_local std::minstd_rand rng(std::random_device{}());
+        std::size_t n = deques_.size(), start = rng() % n;
+        for (std::size_t k = 0; k < n; ++k) {
+            std::size_t victim = (start + k) % n;
+            if (victim == self) continue;
+            if (Job* j = deques_[victim].steal()) return taken(j);
+        }
+        return nullptr;
+    }
+
+    Job* taken(Job* j) {
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        return j;
+    }
+
+    void execute(Job* j) {
+        frame f{ this, running_ };
+        running_ = &f;
+        (*j)();                                        // packaged_task stores result or exception
+        running_ = f.outer;
+        delete j;
+        in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void run(std::size_t self) {
+        current_pool = this;
+        current_worker = self;
+        for (;;) {
+            if (Job* j = find_work(self)) {
+                execute(j);
+                continue;
+            }
+            // Nothing found: sleep until a submit announces new work. Both sides
+            // use seq_cst on pending_/sleepers_, so either the submitter sees
+            // this sleeper or this predicate sees the new work.
+            std::unique_lock lock(mutex_);
+            sleepers_.fetch_add(1);
+            wake_.wait(lock, [&] { return stop_ || pending_.load() > 0; });
+            sleepers_.fetch_sub(1);
+            if (stop_ && pending_.load() <= 0) return;
+        }
+    }
+
+    std::vector<ChaseLevDeque> deques_;
+    std::vector<std::thread> threads_;
+    std::deque<Job*> injected_;                        // Guarded by mutex_
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;                                // Guarded by mutex_
+    std::atomic<std::int64_t> pending_{0};             // Queued, not yet taken
+    std::atomic<std::int64_t> in_flight_{0};           // Submitted, not yet finished
+    std::atomic<int> sleepers_{0};
+};
+
+thread_local WorkStealingPool* WorkStealingPool::current_pool = nullptr;
+thread_local std::size_t WorkStealingPool::current_worker = 0;
+thread_local const WorkStealingPool::frame* WorkStealingPool::running_ = nullptr;
+
+// A small recursive workload: each call splits its range and submits the
+// halves from inside the pool, so they land on worker deques and get stolen.
+void sum_range(WorkStealingPool& pool, std::atomic<long long>& total, long long lo, long long hi) {
+    if (hi - lo <= 1000) {
+        long long s = 0;
+        for (long long i = lo; i < hi; ++i) s += i;
+        total.fetch_add(s, std::memory_order_relaxed);
+        return;
+    }
+    long long mid = lo + (hi - lo) / 2;
+    pool.submit(sum_range, std::ref(pool), std::ref(total), lo, mid);
+    pool.submit(sum_range, std::ref(pool), std::ref(total), mid, hi);
+}
+
+int times3(int x) { return x * 3; }
+
+int main() {
+    std::cout << std::boolalpha;
+    WorkStealingPool pool(std::max(2u, std::thread::hardware_concurrency()));
+
+    // -- 1. submit() returns the packaged_task's future ---------------------
+    {
+        auto fut = pool.submit(times3, 14);
+        int r = fut.get();
+        std::cout << "1. submit result           : " << r << "\n";   // 42
+        assert(r == 42);
+
+        // Arguments arrive as rvalues, so a callable may take them by &&.
+        auto moved = pool.submit([](std::string&& s) { return std::move(s) + "!"; }, std::string("moved"));
+        assert(moved.get() == "moved!");
+    }
+
+    // -- 2. Exceptions still travel through the future ----------------------
+    {
+        auto fut = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+        std::string msg;
+        try { fut.get(); } catch (const std::runtime_error& e) { msg = e.what(); }
+        std::cout << "2. exception propagated    : " << msg << "\n"; // boom
+        assert(msg == "boom");
+    }
+
+    // -- 3. Section 7 of ex_std_packaged_task.cpp, on reused threads --------
+    {
+        auto futures = pool.submit_bulk(4, [](std::size_t i) { int x = int(i) + 1; return x * x; });
+        int sum = 0;
+        std::cout << "3. bulk results            :";
+        for (auto& f : futures) { int v = f.get(); sum += v; std::cout << " " << v; }
+        std::cout << "  (sum=" << sum << ")\n";                       // 1 4 9 16 (sum=30)
+        assert(sum == 30);
+    }
+
+    // -- 4. Tasks that submit tasks, then wait_all() ------------------------
+    {
+        std::atomic<long long> total{0};
+        const long long n = 2'000'000;
+        pool.submit(sum_range, std::ref(pool), std::ref(total), 0LL, n);
+        pool.wait_all();
+        std::cout << "4. recursive sum           : " << total << "\n";
+        assert(total == n * (n - 1) / 2);
+    }
+
+    // -- 5. Throughput: thread-per-task vs the pool -------------------------
+    {
+        using clock = std::chrono::steady_clock;
+        const int tasks = 20'000;
+        auto rate = [&](auto t0) {
+            return tasks / std::chrono::duration<double>(clock::now() - t0).count();
+        };
+
+        auto t0 = clock::now();
+        {
+            // Joined in batches, so the baseline measures spawn cost rather
+            // than the host's limit on live threads.
+            constexpr int batch = 256;
+            std::vector<std::future<int>> futures;
+            std::vector<std::thread> threads;
+            threads.reserve(batch);
+            for (int i = 0; i < tasks; ++i) {
+                std::packaged_task<int(int)> t([](int x) { return x * x; });
+                futures.push_back(t.get_future());
+                threads.emplace_back(std::move(t), i);
+                if (threads.size() == batch) {
+                    for (auto& th : threads) th.join();
+                    threads.clear();
+                }
+            }
+            for (auto& th : threads) th.join();
+            for (auto& f : futures) f.get();
+        }
+        double spawn = rate(t0);
+
+        t0 = clock::now();
+        {
+            std::vector<std::future<int>> futures;
+            futures.reserve(tasks);
+            for (int i = 0; i < tasks; ++i) futures.push_back(pool.submit([](int x) { return x * x; }, i));
+            for (auto& f : futures) f.get();
+        }
+        double single = rate(t0);
+
+        t0 = clock::now();
+        {
+            auto futures = pool.submit_bulk(tasks, [](std::size_t i) { return int(i * i); });
+            for (auto& f : futures) f.get();
+        }
+        double bulk = rate(t0);
+
+        std::cout << "5. tasks/second, " << tasks << " tasks on " << pool.size() << " workers\n"
+                  << "     thread per task       : " << spawn << "\n"
+                  << "     pool.submit           : " << single << "  (" << single / spawn << "x)\n"
+                  << "     pool.submit_bulk      : " << bulk << "  (" << bulk / spawn << "x)\n";
+    }
+
+    // -- Notes --------------------------------------------------------------
+    // Each worker's deque is LIFO for its owner and FIFO for thieves: the owner
+    // keeps working on the freshest (cache-warm) subtask, while a thief takes
+    // the oldest one, which in divide-and-conquer code is usually the largest.
+    // A task that blocks on another task's future ties up its worker, and
+    // wait_all() is for callers outside the pool; inside a task, prefer
+    // continuation-style submission, as in sum_range.
+    std::cout << "\ndone\n";
+}
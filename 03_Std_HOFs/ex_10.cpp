@@ -0,0 +1,446 @@
+/**
+ * Logistic fleet management — structure-of-arrays telemetry with SIMD kernels
+ *
+ * `struct Telemetry` in ex_02.cpp is array-of-structs, and each row owns a
+ * `std::string truck_id`. A pass such as is_active_fleet or calculate_mpg needs
+ * two or three fields, yet every row it touches brings the whole struct
+ * (60+ bytes on a 64-bit target) into the cache.
+ *
+ * This example stores the same data column by column:
+ * 1. `TelemetryTable` keeps one contiguous vector per field, and interns each
+ *    truck ID once, so a row stores only a small integer.
+ * 2. The MPG transform, the MPG filter and the two safety predicates are
+ *    written as kernels over the columns, vectorised with AVX2 (4 doubles /
+ *    8 ints per step) or SSE2 (2 doubles / 4 ints), with a scalar fallback
+ *    that also handles the tail.
+ * 3. `TelemetryTable::rows()` is a random-access range of lightweight
+ *    `TelemetryRow` values with the same member names as `Telemetry`, so the
+ *    views pipeline from ex_02.cpp still composes over the table.
+ *
+ * `main` checks the kernels against the ex_02.cpp pipeline and times both.
+ *
+ *   Build : g++ -std=c++23 -O2 -mavx2 -o telemetry_soa ex_10.cpp
+ *           (drop -mavx2 to run the SSE2 path)
+ *   Run   : ./telemetry_soa [rows]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define FLEET_SIMD "AVX2"
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define FLEET_SIMD "SSE2"
+#else
+#define FLEET_SIMD "scalar"
+#endif
+
+// --- Data Structures ---
+
+// The row-oriented record from ex_02.cpp, used as the input format.
+struct Telemetry {
+    std::string truck_id;
+    double miles_driven;
+    double fuel_used_gallons;
+    int engine_hours;
+    bool maintenance_required;
+    int safety_score; // 0-100
+};
+
+// Interns truck IDs: each distinct string is stored once, and rows refer to it
+// by index. A deque keeps the strings at stable addresses, so the map can be
+// keyed by string_view into them.
+class TruckIdPool {
+    std::deque<std::string> names_;
+    std::unordered_map<std::string_view, std::uint32_t> index_;
+
+public:
+    TruckIdPool() = default;
+    // A copy gets its own strings, so its keys must point into those, not
+    // into the source's. Moving a deque keeps its elements where they are.
+    TruckIdPool(const TruckIdPool& o) : names_(o.names_) { reindex(); }
+    TruckIdPool& operator=(const TruckIdPool& o) {
+        if (this != &o) { names_ = o.names_; reindex(); }
+        return *this;
+    }
+    TruckIdPool(TruckIdPool&&) = default;
+    TruckIdPool& operator=(TruckIdPool&&) = default;
+
+    std::uint32_t intern(std::string_view id) {
+        if (auto it = index_.find(id); it != index_.end()) return it->second;
+        auto key = static_cast<std::uint32_t>(names_.size());
+        index_.emplace(names_.emplace_back(id), key);
+        return key;
+    }
+
+    std::string_view name(std::uint32_t key) const { return names_[key]; }
+    std::size_t size() const { return names_.size(); }
+
+private:
+    void reindex() {
+        index_.clear();
+        for (std::uint32_t k = 0; k < names_.size(); ++k) index_.emplace(names_[k], k);
+    }
+};
+
+// One row of the table, assembled on demand from the columns. It mirrors the
+// member names of `Telemetry`, so field-based HOFs work on either.
+struct TelemetryRow {
+    std::string_view truck_id;
+    double miles_driven;
+    double fuel_used_gallons;
+    int engine_hours;
+    bool maintenance_required;
+    int safety_score;
+};
+
+class TelemetryTable {
+public:
+    // The columns are public on purpose: the kernels below read them directly.
+    std::vector<std::uint32_t> truck_key;
+    std::vector<double> miles_driven;
+    std::vector<double> fuel_used_gallons;
+    std::vector<std::int32_t> engine_hours;
+    std::vector<std::uint8_t> maintenance_required;   // 0 or 1
+    std::vector<std::int32_t> safety_score;
+
+    TelemetryTable() = default;
+
+    explicit TelemetryTable(const std::vector<Telemetry>& logs) {
+        reserve(logs.size());
+        for (const Telemetry& t : logs) push_back(t);
+    }
+
+    void reserve(std::size_t n) {
+        truck_key.reserve(n);
+        miles_driven.reserve(n);
+        fuel_used_gallons.reserve(n);
+        engine_hours.reserve(n);
+        maintenance_required.reserve(n);
+        safety_score.reserve(n);
+    }
+
+    void push_back(const Telemetry& t) {
+        truck_key.push_back(ids_.intern(t.truck_id));
+        miles_driven.push_back(t.miles_driven);
+        fuel_used_gallons.push_back(t.fuel_used_gallons);
+        engine_hours.push_back(t.engine_hours);
+        maintenance_required.push_back(t.maintenance_required);
+        safety_score.push_back(t.safety_score);
+    }
+
+    std::size_t size() const { return miles_driven.size(); }
+    const TruckIdPool& ids() const { return ids_; }
+
+    TelemetryRow operator[](std::size_t i) const {
+        return {ids_.name(truck_key[i]), miles_driven[i], fuel_used_gallons[i],
+                engine_hours[i], maintenance_required[i] != 0, safety_score[i]};
+    }
+
+    // A random-access, sized view of rows. Nothing is copied until a row is
+    // read. The view refers to the table, so a temporary one is rejected.
+    auto rows() const& {
+        return std::views::iota(std::size_t{0}, size())
+             | std::views::transform([this](std::size_t i) { return (*this)[i]; });
+    }
+    void rows() const&& = delete;
+
+private:
+    TruckIdPool ids_;
+};
+
+// --- Higher-Order Function Factories ---
+// As in ex_02.cpp, but generic over the row type, so the same policy applies to
+// a `Telemetry` or to a `TelemetryRow` read out of the table.
+
+auto is_active_fleet(int min_safety) {
+    return [=](const auto& t) {
+        return !t.maintenance_required && t.safety_score >= min_safety;
+    };
+}
+
+auto calculate_mpg() {
+    return [](const auto& t) {
+        return t.fuel_used_gallons > 0 ? t.miles_driven / t.fuel_used_gallons : 0.0;
+    };
+}
+
+// --- Column Kernels ---
+
+namespace kernels {
+
+// out[i] = fuel[i] > 0 ? miles[i] / fuel[i] : 0.0, for every row.
+void mpg_transform(const TelemetryTable& t, std::span<double> out) {
+    const double* miles = t.miles_driven.data();
+    const double* fuel = t.fuel_used_gallons.data();
+    std::size_t n = t.size(), i = 0;
+
+#if defined(__AVX2__)
+    const __m256d zero = _mm256_setzero_pd();
+    for (; i + 4 <= n; i += 4) {
+        __m256d m = _mm256_loadu_pd(miles + i), f = _mm256_loadu_pd(fuel + i);
+        __m256d ok = _mm256_cmp_pd(f, zero, _CMP_GT_OQ);
+        _mm256_storeu_pd(out.data() + i, _mm256_and_pd(ok, _mm256_div_pd(m, f)));
+    }
+#elif defined(__SSE2__)
+    const __m128d zero = _mm_setzero_pd();
+    for (; i + 2 <= n; i += 2) {
+        __m128d m = _mm_loadu_pd(miles + i), f = _mm_loadu_pd(fuel + i);
+        __m128d ok = _mm_cmpgt_pd(f, zero);
+        _mm_storeu_pd(out.data() + i, _mm_and_pd(ok, _mm_div_pd(m, f)));
+    }
+#endif
+    for (; i < n; ++i) out[i] = fuel[i] > 0 ? miles[i] / fuel[i] : 0.0;
+}
+
+// Appends the MPG of every row that is active (no maintenance, safety score at
+// least min_safety) and above the noise floor, in row order. This is the fused
+// form of filter(is_active_fleet) | transform(calculate_mpg) | filter(mpg > floor).
+std::size_t mpg_filter(const TelemetryTable& t, int min_safety, double floor, std::vector<double>& out) {
+    const double* miles = t.miles_driven.data();
+    const double* fuel = t.fuel_used_gallons.data();
+    const std::uint8_t* maint = t.maintenance_required.data();
+    const std::int32_t* safety = t.safety_score.data();
+    std::size_t n = t.size(), i = 0, before = out.size();
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    // Lanes are computed in full, then the passing ones are compacted through
+    // the movemask bits, which keeps the per-row branch out of the hot loop.
+    auto keep = [&](unsigned bits, const double* mpg, std::size_t lanes) {
+        for (std::size_t l = 0; l < lanes; ++l)
+            if (bits >> l & 1u) out.push_back(mpg[l]);
+    };
+#endif
+
+#if defined(__AVX2__)
+    const __m256d zero = _mm256_setzero_pd(), lo = _mm256_set1_pd(floor);
+    const __m256d min_s = _mm256_set1_pd(min_safety);
+    alignas(32) double mpg[4];
+    for (; i + 4 <= n; i += 4) {
+        __m256d m = _mm256_loadu_pd(miles + i), f = _mm256_loadu_pd(fuel + i);
+        __m256d v = _mm256_and_pd(_mm256_cmp_pd(f, zero, _CMP_GT_OQ), _mm256_div_pd(m, f));
+
+        std::int32_t packed;
+        std::memcpy(&packed, maint + i, sizeof packed);
+        __m256i mt = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(packed));
+        __m256d no_maint = _mm256_castsi256_pd(_mm256_cmpeq_epi64(mt, _mm256_setzero_si256()));
+        __m256d s = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(safety + i)));
+
+        __m256d pass = _mm256_and_pd(no_maint, _mm256_cmp_pd(s, min_s, _CMP_GE_OQ));
+        pass = _mm256_and_pd(pass, _mm256_cmp_pd(v, lo, _CMP_GT_OQ));
+        if (unsigned bits = _mm256_movemask_pd(pass)) {
+            _mm256_store_pd(mpg, v);
+            keep(bits, mpg, 4);
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128d zero = _mm_setzero_pd(), lo = _mm_set1_pd(floor);
+    const __m128d min_s = _mm_set1_pd(min_safety);
+    alignas(16) double mpg[2];
+    for (; i + 2 <= n; i += 2) {
+        __m128d m = _mm_loadu_pd(miles + i), f = _mm_loadu_pd(fuel + i);
+        __m128d v = _mm_and_pd(_mm_cmpgt_pd(f, zero), _mm_div_pd(m, f));
+
+        __m128d no_maint = _mm_castsi128_pd(_mm_set_epi64x(-std::int64_t{maint[i + 1] == 0},
+                                                           -std::int64_t{maint[i] == 0}));
+        __m128d s = _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(safety + i)));
+
+        __m128d pass = _mm_and_pd(no_maint, _mm_cmpge_pd(s, min_s));
+        pass = _mm_and_pd(pass, _mm_cmpgt_pd(v, lo));
+        if (unsigned bits = _mm_movemask_pd(pass)) {
+            _mm_store_pd(mpg, v);
+            keep(bits, mpg, 2);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (maint[i] || safety[i] < min_safety) continue;
+        double v = fuel[i] > 0 ? miles[i] / fuel[i] : 0.0;
+        if (v > floor) out.push_back(v);
+    }
+    return out.size() - before;
+}
+
+// True when every safety score is strictly above `threshold`.
+bool all_safety_above(const TelemetryTable& t, int threshold) {
+    const std::int32_t* s = t.safety_score.data();
+    std::size_t n = t.size(), i = 0;
+
+#if defined(__AVX2__)
+    const __m256i th = _mm256_set1_epi32(threshold);
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        if (_mm256_movemask_epi8(_mm256_cmpgt_epi32(v, th)) != -1) return false;
+    }
+#elif defined(__SSE2__)
+    const __m128i th = _mm_set1_epi32(threshold);
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        if (_mm_movemask_epi8(_mm_cmpgt_epi32(v, th)) != 0xFFFF) return false;
+    }
+#endif
+    for (; i < n; ++i)
+        if (!(s[i] > threshold)) return false;
+    return true;
+}
+
+// True when any single trip is strictly longer than `miles`.
+bool any_miles_above(const TelemetryTable& t, double miles) {
+    const double* m = t.miles_driven.data();
+    std::size_t n = t.size(), i = 0;
+
+#if defined(__AVX2__)
+    const __m256d th = _mm256_set1_pd(miles);
+    for (; i + 4 <= n; i += 4)
+        if (_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(m + i), th, _CMP_GT_OQ))) return true;
+#elif defined(__SSE2__)
+    const __m128d th = _mm_set1_pd(miles);
+    for (; i + 2 <= n; i += 2)
+        if (_mm_movemask_pd(_mm_cmpgt_pd(_mm_loadu_pd(m + i), th))) return true;
+#endif
+    for (; i < n; ++i)
+        if (m[i] > miles) return true;
+    return false;
+}
+
+} // namespace kernels
+
+// --- Verification and Benchmark ---
+
+std::vector<Telemetry> synthetic_fleet(std::size_t rows) {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> miles(50.0, 1000.0), mpg(1.5, 14.0);
+    std::uniform_int_distribution<int> hours(1, 24), safety(51, 100), maint(0, 9), truck(0, 4999);
+
+    std::vector<Telemetry> logs;
+    logs.reserve(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        double m = miles(gen);
+        logs.push_back({"T-" + std::to_string(truck(gen)), m, m / mpg(gen), hours(gen), maint(gen) == 0, safety(gen)});
+    }
+    // Leave one zero-fuel row and one mid-stream failing score in, so the
+    // kernels' edge cases are exercised.
+    if (rows > 10) {
+        logs[3].fuel_used_gallons = 0.0;
+        logs[rows / 2].safety_score = 40;
+    }
+    return logs;
+}
+
+template <class F>
+double best_ms(F&& f, int reps = 5) {
+    double best = 1e300;
+    for (int i = 0; i < reps; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(t1 - t0).count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    std::vector<Telemetry> fleet_logs = {
+        {"T-01", 450.5, 45.0, 12, false, 95},
+        {"T-02", 820.0, 92.0, 20, false, 88},
+        {"T-03", 120.0, 15.0, 4,  true,  40}, // Maintenance required
+        {"T-04", 600.0, 55.0, 15, false, 92},
+        {"T-05", 950.0, 110.0, 24, false, 85},
+        {"T-01", 300.0, 28.0, 9,  false, 91}  // Same truck, second trip
+    };
+    TelemetryTable table(fleet_logs);
+
+    // 1. The ex_02.cpp pipeline, unchanged in shape, now running over the table.
+    auto active_efficiency_view = table.rows()
+        | std::views::filter(is_active_fleet(70))
+        | std::views::transform(calculate_mpg())
+        | std::views::filter([](double mpg) { return mpg > 2.0; });
+
+    std::cout << "=== Columnar Fleet (" << FLEET_SIMD << " kernels) ===\n";
+    std::cout << "Rows: " << table.size() << ", distinct trucks: " << table.ids().size() << "\n";
+    std::cout << "Active MPG via ranges view: ";
+    for (double mpg : active_efficiency_view) std::cout << mpg << " ";
+
+    // 2. The same question answered by the fused column kernel.
+    std::vector<double> mpgs;
+    kernels::mpg_filter(table, 70, 2.0, mpgs);
+    std::cout << "\nActive MPG via SIMD kernel: ";
+    for (double mpg : mpgs) std::cout << mpg << " ";
+
+    std::cout << "\nOperational Safety: " << (kernels::all_safety_above(table, 50) ? "PASS" : "FAIL") << "\n";
+    std::cout << "High Util. Alert:   " << (kernels::any_miles_above(table, 800.0) ? "YES" : "NO") << "\n";
+
+    // 3. Check every kernel against the row-oriented pipeline on a large batch.
+    std::size_t rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    auto logs = synthetic_fleet(rows);
+    TelemetryTable big(logs);
+
+    auto aos_filter = [&] {
+        auto v = logs | std::views::filter(is_active_fleet(70))
+                      | std::views::transform(calculate_mpg())
+                      | std::views::filter([](double mpg) { return mpg > 2.0; });
+        return std::vector<double>(v.begin(), v.end());
+    };
+    auto soa_filter = [&] {
+        std::vector<double> out;
+        out.reserve(big.size());
+        kernels::mpg_filter(big, 70, 2.0, out);
+        return out;
+    };
+    auto aos_transform = [&] {
+        std::vector<double> out(logs.size());
+        std::ranges::transform(logs, out.begin(), calculate_mpg());
+        return out;
+    };
+    auto soa_transform = [&] {
+        std::vector<double> out(big.size());
+        kernels::mpg_transform(big, out);
+        return out;
+    };
+    auto aos_all = [&] { return std::ranges::all_of(logs, [](const Telemetry& t) { return t.safety_score > 50; }); };
+    auto aos_any = [&] { return std::ranges::any_of(logs, [](const Telemetry& t) { return t.miles_driven > 1000.0; }); };
+
+    // The table's row view must reproduce the source rows as well.
+    bool ok = std::ranges::equal(logs, big.rows(), [](const Telemetry& a, const TelemetryRow& b) {
+        return a.truck_id == b.truck_id && a.miles_driven == b.miles_driven && a.safety_score == b.safety_score;
+    });
+    ok = ok && aos_filter() == soa_filter() && aos_transform() == soa_transform()
+            && aos_all() == kernels::all_safety_above(big, 50)
+            && aos_any() == kernels::any_miles_above(big, 1000.0);
+
+    // A copy outlives its source: interning a known ID still finds it.
+    TelemetryTable copy = [&] { TelemetryTable src(fleet_logs); return TelemetryTable(src); }();
+    copy.push_back(fleet_logs[0]);
+    ok = ok && copy.ids().size() == table.ids().size() && copy.truck_key.back() == copy.truck_key.front();
+
+    std::cout << "\n=== Benchmark: " << rows << " rows (" << big.ids().size() << " distinct trucks) ===\n";
+    std::cout << "Bytes per row: AoS " << sizeof(Telemetry) << ", SoA "
+              << sizeof(std::uint32_t) + 2 * sizeof(double) + 2 * sizeof(std::int32_t) + sizeof(std::uint8_t) << "\n";
+    auto bench = [](const char* name, auto&& aos, auto&& soa) {
+        double a = best_ms([&] { volatile auto r = aos(); (void)r; });
+        double s = best_ms([&] { volatile auto r = soa(); (void)r; });
+        std::cout << name << "AoS " << a << " ms, SoA " << s << " ms (" << a / s << "x)\n";
+    };
+    bench("MPG filter:        ", [&] { return aos_filter().size(); }, [&] { return soa_filter().size(); });
+    bench("MPG transform:     ", [&] { return aos_transform().size(); }, [&] { return soa_transform().size(); });
+    bench("all(safety > 50):  ", aos_all, [&] { return kernels::all_safety_above(big, 50); });
+    bench("any(miles > 1000): ", aos_any, [&] { return kernels::any_miles_above(big, 1000.0); });
+    std::cout << "Results agree:      " << (ok ? "YES" : "NO") << "\n";
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,380 @@
+/**
+ * Logistic fleet management — streaming, mergeable fleet report
+ *
+ * `generate_fleet_report` in ex_02.cpp needs the whole log in memory, and
+ * answers one question per call by recomputing everything from scratch. When
+ * telemetry arrives in batches, that means keeping every row and paying for a
+ * full rebuild on each refresh.
+ *
+ * `FleetReportAccumulator` turns the report into a fold instead:
+ * 1. `ingest(chunk)` updates running state in O(1) work per row: sums, counts,
+ *    the maximum trip, the all/any safety flags, a fixed-size histogram of
+ *    efficiencies and a bounded top-k leaderboard.
+ * 2. Only the last `tail` entries of the cumulative-mileage series are kept,
+ *    in a ring, so memory is bounded no matter how many rows were seen.
+ * 3. `report()` can be called at any time, and costs O(bins + k + tail).
+ * 4. `merge(other)` combines two accumulators as if `other`'s rows had been
+ *    ingested after this one's. Shards can therefore be ingested on separate
+ *    threads and merged in shard order.
+ *
+ * Percentiles of the efficiency distribution are estimated from the histogram,
+ * so they are exact to within one bin width.
+ *
+ *   Build : g++ -std=c++23 -O2 -pthread -o streaming_fleet ex_11.cpp
+ *   Run   : ./streaming_fleet
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// --- Data Structures (as in ex_02.cpp) ---
+
+struct Telemetry {
+    std::string truck_id;
+    double miles_driven;
+    double fuel_used_gallons;
+    int engine_hours;
+    bool maintenance_required;
+    int safety_score; // 0-100
+};
+
+struct FleetReport {
+    double total_mileage = 0.0;
+    double avg_efficiency = 0.0; // MPG
+    double max_miles_single_trip = 0.0;
+    int critical_maintenance_count = 0;
+    int fleet_size = 0;
+
+    bool operational_integrity = true; // All safety scores > threshold
+    bool high_utilization_detected = false; // Any truck > X miles
+
+    std::vector<double> efficiency_distribution;
+    std::vector<double> cumulative_mileage;
+};
+
+// --- Higher-Order Function Factories (as in ex_02.cpp) ---
+
+auto is_active_fleet(int min_safety) {
+    return [=](const Telemetry& t) {
+        return !t.maintenance_required && t.safety_score >= min_safety;
+    };
+}
+
+auto calculate_mpg() {
+    return [](const Telemetry& t) {
+        return t.fuel_used_gallons > 0 ? t.miles_driven / t.fuel_used_gallons : 0.0;
+    };
+}
+
+auto by_efficiency() {
+    return std::greater<double>();
+}
+
+// --- The Streaming Accumulator ---
+
+class FleetReportAccumulator {
+public:
+    static constexpr std::size_t kBins = 64;
+    static constexpr double kMaxMpg = 32.0;   // Efficiencies above this share the last bin
+
+    // top_k bounds the leaderboard, tail bounds the cumulative-mileage series.
+    explicit FleetReportAccumulator(std::size_t top_k = 10, std::size_t tail = 16)
+        : top_k_(top_k), tail_(tail) { ring_.reserve(tail); }
+
+    void ingest(const Telemetry& t) {
+        ++rows_;
+        total_mileage_ += t.miles_driven;
+        push_cumulative(total_mileage_);
+        max_miles_ = std::max(max_miles_, t.miles_driven);
+        maintenance_ += t.maintenance_required;
+        all_safe_ = all_safe_ && t.safety_score > 50;
+        any_high_ = any_high_ || t.miles_driven > 800.0;
+
+        if (!is_active_fleet(70)(t)) return;
+        double mpg = calculate_mpg()(t);
+        if (mpg <= 2.0) return;
+
+        ++active_;
+        efficiency_sum_ += mpg;
+        ++histogram_[bin_of(mpg)];
+        offer(mpg);
+    }
+
+    void ingest(std::span<const Telemetry> chunk) {
+        for (const Telemetry& t : chunk) ingest(t);
+    }
+
+    // Appends other's rows logically after this accumulator's rows. Both must
+    // have been built with the same top_k and tail.
+    FleetReportAccumulator& merge(const FleetReportAccumulator& other) {
+        if (other.top_k_ != top_k_ || other.tail_ != tail_)
+            throw std::invalid_argument("merge: accumulators differ in top_k or tail");
+        // The loops below read other while changing *this; a self-merge
+        // reads from a snapshot instead.
+        if (&other == this) return merge(FleetReportAccumulator(other));
+
+        // other's cumulative values are relative to its own start, so they are
+        // shifted by our running total before being appended in order.
+        for (double c : other.tail_values()) push_cumulative(total_mileage_ + c);
+
+        rows_ += other.rows_;
+        total_mileage_ += other.total_mileage_;
+        max_miles_ = std::max(max_miles_, other.max_miles_);
+        maintenance_ += other.maintenance_;
+        all_safe_ = all_safe_ && other.all_safe_;
+        any_high_ = any_high_ || other.any_high_;
+        active_ += other.active_;
+        efficiency_sum_ += other.efficiency_sum_;
+        for (std::size_t b = 0; b < kBins; ++b) histogram_[b] += other.histogram_[b];
+        for (double v : other.top_) offer(v);
+        return *this;
+    }
+
+    // A snapshot in the shape of ex_02.cpp's report. efficiency_distribution
+    // holds the top-k leaderboard and cumulative_mileage the retained tail.
+    FleetReport report() const {
+        FleetReport r;
+        r.fleet_size = static_cast<int>(active_);
+        if (active_ == 0) return r;
+
+        r.avg_efficiency = efficiency_sum_ / active_;
+        r.total_mileage = total_mileage_;
+        r.max_miles_single_trip = max_miles_;
+        r.critical_maintenance_count = static_cast<int>(maintenance_);
+        r.operational_integrity = all_safe_;
+        r.high_utilization_detected = any_high_;
+        r.efficiency_distribution = top_;
+        std::sort_heap(r.efficiency_distribution.begin(), r.efficiency_distribution.end(), by_efficiency());
+        r.cumulative_mileage = tail_values();
+        return r;
+    }
+
+    // Estimated q-quantile (0 <= q <= 1) of the active efficiencies, by linear
+    // interpolation inside the histogram bin that contains it.
+    double efficiency_quantile(double q) const {
+        if (active_ == 0) return 0.0;
+        double target = std::clamp(q, 0.0, 1.0) * active_;
+        double seen = 0.0;
+        for (std::size_t b = 0; b < kBins; ++b) {
+            if (histogram_[b] == 0) continue;
+            if (seen + histogram_[b] >= target)
+                return (b + (target - seen) / histogram_[b]) * kWidth;
+            seen += histogram_[b];
+        }
+        return kMaxMpg;
+    }
+
+    std::size_t rows_seen() const { return rows_; }
+
+private:
+    static constexpr double kWidth = kMaxMpg / kBins;
+
+    // Clamped as a double: a tiny fuel reading gives an mpg far beyond what
+    // size_t can hold.
+    static std::size_t bin_of(double mpg) {
+        return static_cast<std::size_t>(std::min(mpg / kWidth, double(kBins - 1)));
+    }
+
+    // Keeps the k largest efficiencies as a min-heap under by_efficiency().
+    void offer(double mpg) {
+        if (top_k_ == 0) return;
+        if (top_.size() < top_k_) {
+            top_.push_back(mpg);
+            std::push_heap(top_.begin(), top_.end(), by_efficiency());
+        } else if (mpg > top_.front()) {
+            std::pop_heap(top_.begin(), top_.end(), by_efficiency());
+            top_.back() = mpg;
+            std::push_heap(top_.begin(), top_.end(), by_efficiency());
+        }
+    }
+
+    // The ring holds the newest `tail_` cumulative values; head_ is the oldest.
+    void push_cumulative(double c) {
+        if (tail_ == 0) return;
+        if (ring_.size() < tail_) {
+            ring_.push_back(c);
+        } else {
+            ring_[head_] = c;
+            head_ = (head_ + 1) % tail_;
+        }
+    }
+
+    std::vector<double> tail_values() const {
+        std::vector<double> out(ring_.size());
+        std::rotate_copy(ring_.begin(), ring_.begin() + head_, ring_.end(), out.begin());
+        return out;
+    }
+
+    std::size_t top_k_, tail_;
+    std::size_t rows_ = 0, active_ = 0, maintenance_ = 0;
+    double total_mileage_ = 0.0, efficiency_sum_ = 0.0;
+    double max_miles_ = -std::numeric_limits<double>::infinity();
+    bool all_safe_ = true, any_high_ = false;
+    std::array<std::size_t, kBins> histogram_{};
+    std::vector<double> top_;
+    std::vector<double> ring_;
+    std::size_t head_ = 0;
+};
+
+// --- Reference: the batch engine from ex_02.cpp (sequential policies) ---
+
+FleetReport generate_fleet_report(const std::vector<Telemetry>& logs) {
+    auto active_efficiency_view = logs
+        | std::views::filter(is_active_fleet(70))
+        | std::views::transform(calculate_mpg())
+        | std::views::filter([](double mpg) { return mpg > 2.0; });
+
+    std::vector<double> efficiencies(active_efficiency_view.begin(), active_efficiency_view.end());
+
+    FleetReport report;
+    report.fleet_size = efficiencies.size();
+    if (report.fleet_size == 0) return report;
+
+    report.avg_efficiency = std::reduce(efficiencies.begin(), efficiencies.end(), 0.0) / report.fleet_size;
+
+    auto mileage_view = logs | std::views::transform(&Telemetry::miles_driven);
+    std::vector<double> mileages(mileage_view.begin(), mileage_view.end());
+
+    report.total_mileage = std::reduce(mileages.begin(), mileages.end(), 0.0);
+    report.max_miles_single_trip = *std::max_element(mileages.begin(), mileages.end());
+    report.operational_integrity = std::all_of(logs.begin(), logs.end(),
+        [](const Telemetry& t) { return t.safety_score > 50; });
+    report.high_utilization_detected = std::any_of(mileages.begin(), mileages.end(),
+        [](double m) { return m > 800.0; });
+
+    report.cumulative_mileage.resize(mileages.size());
+    std::inclusive_scan(mileages.begin(), mileages.end(), report.cumulative_mileage.begin());
+
+    report.efficiency_distribution = efficiencies;
+    std::sort(report.efficiency_distribution.begin(), report.efficiency_distribution.end(), by_efficiency());
+    return report;
+}
+
+// --- Demonstration ---
+
+std::vector<Telemetry> synthetic_fleet(std::size_t rows) {
+    std::mt19937 gen(2024);
+    std::uniform_real_distribution<double> miles(50.0, 1000.0), mpg(1.5, 14.0);
+    std::uniform_int_distribution<int> hours(1, 24), safety(45, 100), maint(0, 9);
+
+    std::vector<Telemetry> logs;
+    logs.reserve(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        double m = miles(gen);
+        logs.push_back({"T-" + std::to_string(i % 500), m, m / mpg(gen), hours(gen), maint(gen) == 0, safety(gen)});
+    }
+    return logs;
+}
+
+bool near(double a, double b) { return std::abs(a - b) <= 1e-6 * std::max({1.0, std::abs(a), std::abs(b)}); }
+
+int main() {
+    std::vector<Telemetry> fleet_logs = {
+        {"T-01", 450.5, 45.0, 12, false, 95},
+        {"T-02", 820.0, 92.0, 20, false, 88},
+        {"T-03", 120.0, 15.0, 4,  true,  40}, // Maintenance required
+        {"T-04", 600.0, 55.0, 15, false, 92},
+        {"T-05", 950.0, 110.0, 24, false, 85}
+    };
+
+    // 1. Rows arrive in two batches; the report is queryable after each one.
+    FleetReportAccumulator live(3, 3);
+    std::span<const Telemetry> all(fleet_logs);
+
+    live.ingest(all.first(2));
+    std::cout << "After batch 1: " << live.report().fleet_size << " active, "
+              << live.report().total_mileage << " miles\n";
+
+    live.ingest(all.subspan(2));
+    FleetReport r = live.report();
+    std::cout << "After batch 2: " << r.fleet_size << " active, " << r.total_mileage << " miles\n";
+    std::cout << "Avg Fuel Efficiency: " << r.avg_efficiency << " MPG\n";
+    std::cout << "Operational Safety:  " << (r.operational_integrity ? "PASS" : "FAIL") << "\n";
+    std::cout << "High Util. Alert:    " << (r.high_utilization_detected ? "YES" : "NO") << "\n";
+    std::cout << "Mileage tail:       ";
+    for (double c : r.cumulative_mileage) std::cout << " " << c;
+    std::cout << "\nTop-3 MPG:          ";
+    for (double v : r.efficiency_distribution) std::cout << " " << v;
+    std::cout << "\n";
+
+    // 2. A larger log is sharded across threads, one accumulator per shard,
+    //    ingested in small chunks and merged back in shard order.
+    auto logs = synthetic_fleet(400'000);
+    unsigned shards = std::max(2u, std::thread::hardware_concurrency());
+    std::size_t per = (logs.size() + shards - 1) / shards;
+
+    std::vector<FleetReportAccumulator> parts(shards, FleetReportAccumulator(10, 16));
+    std::vector<std::thread> workers;
+    for (unsigned s = 0; s < shards; ++s) {
+        workers.emplace_back([&, s] {
+            std::span<const Telemetry> shard(logs);
+            shard = shard.subspan(std::min(logs.size(), s * per));
+            shard = shard.first(std::min(per, shard.size()));
+            for (std::size_t i = 0; i < shard.size(); i += 1000)
+                parts[s].ingest(shard.subspan(i, std::min<std::size_t>(1000, shard.size() - i)));
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    FleetReportAccumulator merged(10, 16);
+    for (const auto& p : parts) merged.merge(p);
+
+    // 3. The merged snapshot must match the batch report on the whole log.
+    FleetReport got = merged.report(), want = generate_fleet_report(logs);
+    bool ok = got.fleet_size == want.fleet_size
+           && near(got.avg_efficiency, want.avg_efficiency)
+           && near(got.total_mileage, want.total_mileage)
+           && got.max_miles_single_trip == want.max_miles_single_trip
+           && got.operational_integrity == want.operational_integrity
+           && got.high_utilization_detected == want.high_utilization_detected
+           && std::equal(got.efficiency_distribution.begin(), got.efficiency_distribution.end(),
+                         want.efficiency_distribution.begin())
+           && std::ranges::equal(got.cumulative_mileage,
+                                 want.cumulative_mileage | std::views::drop(want.cumulative_mileage.size() - 16),
+                                 near);
+
+    // The median estimate must fall within one bin of the exact median.
+    const auto& sorted = want.efficiency_distribution;     // descending
+    double exact_median = sorted[sorted.size() / 2];
+    double est_median = merged.efficiency_quantile(0.5);
+    ok = ok && std::abs(est_median - exact_median) <= FleetReportAccumulator::kMaxMpg / FleetReportAccumulator::kBins;
+
+    // A near-zero fuel reading lands in the last bin, as in the batch report.
+    std::vector<Telemetry> odd_logs = fleet_logs;
+    odd_logs.push_back({"T-99", 500.0, 1e-300, 10, false, 90});
+    FleetReportAccumulator odd(10, 16);
+    odd.ingest(odd_logs);
+    ok = ok && odd.report().efficiency_distribution.front() == generate_fleet_report(odd_logs).efficiency_distribution.front();
+
+    // Accumulators of different shapes cannot be merged.
+    bool rejected = false;
+    try { FleetReportAccumulator(10, 16).merge(FleetReportAccumulator(3, 16)); }
+    catch (const std::invalid_argument&) { rejected = true; }
+    ok = ok && rejected;
+
+    // Merging an accumulator into itself is the same as merging a copy.
+    FleetReportAccumulator twice = parts[0], expect = parts[0];
+    twice.merge(twice);
+    expect.merge(FleetReportAccumulator(parts[0]));
+    FleetReport t = twice.report(), e = expect.report();
+    ok = ok && t.fleet_size == e.fleet_size && t.total_mileage == e.total_mileage
+            && t.efficiency_distribution == e.efficiency_distribution && t.cumulative_mileage == e.cumulative_mileage;
+
+    std::cout << "\nSharded ingest: " << merged.rows_seen() << " rows over " << shards << " threads\n";
+    std::cout << "Median MPG: estimated " << est_median << ", exact " << exact_median << "\n";
+    std::cout << "Matches batch report: " << (ok ? "YES" : "NO") << "\n";
+
+    return ok ? 0 : 1;
+}
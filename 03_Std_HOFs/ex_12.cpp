@@ -0,0 +1,305 @@
+/**
+ * E-commerce analytics — columnar sales store with interned categories
+ *
+ * In ex_01.cpp every `Sale` owns a `std::string category`, so the pipeline
+ * copies strings whenever a Sale is copied (the `transform([](Sale s){...})`
+ * step takes its argument by value), and the electronics split runs
+ * `category.find("electronics")` on every element it inspects.
+ *
+ * `SalesColumns` stores the same data as three columns:
+ * 1. `amount`   — a dense std::vector<int>.
+ * 2. `category` — one small integer per row, indexing a dictionary that holds
+ *                 each distinct category string exactly once.
+ * 3. `valid`    — a bitmap, 64 rows per word.
+ *
+ * A category predicate is evaluated once per DICTIONARY ENTRY, never per row.
+ * The result is a set of matching ids, and selecting rows becomes an integer
+ * compare that is ANDed into the validity bitmap one 64-row word at a time.
+ *
+ * `rows(bitmap)` is a bidirectional view over the set bits of a bitmap, which
+ * yields lightweight `SaleRef` values read straight from the columns, so the
+ * ranges pipeline from ex_01.cpp runs without copying a single Sale.
+ *
+ *   Build : g++ -std=c++23 -O2 -o sales_columns ex_12.cpp
+ *   Run   : ./sales_columns
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The row-oriented record from ex_01.cpp, used as the input format.
+struct Sale {
+    int amount;
+    std::string category;
+    bool valid;
+};
+
+// =============================================================================
+// 1. BITMAP AND ITS SET-BIT VIEW
+// =============================================================================
+// One bit per row. Bits past size() in the last word are always zero, so whole
+// words can be ANDed/ORed without masking the tail.
+struct Bitmap {
+    std::vector<std::uint64_t> words;
+    std::size_t size = 0;
+
+    explicit Bitmap(std::size_t n = 0) : words((n + 63) / 64), size(n) {}
+
+    void set(std::size_t i) { words[i / 64] |= std::uint64_t{1} << (i % 64); }
+    bool test(std::size_t i) const { return words[i / 64] >> (i % 64) & 1u; }
+
+    std::size_t count() const {
+        std::size_t c = 0;
+        for (auto w : words) c += std::popcount(w);
+        return c;
+    }
+};
+
+// A bidirectional view over the indices of the set bits of a bitmap. Moving
+// between set bits skips whole zero words via countr_zero / countl_zero.
+class set_bits_view : public std::ranges::view_interface<set_bits_view> {
+    const Bitmap* bits_ = nullptr;
+
+public:
+    class iterator {
+        const Bitmap* bits_ = nullptr;
+        std::size_t pos_ = 0;             // A set bit, or bits_->size for end()
+
+    public:
+        using value_type        = std::size_t;
+        using difference_type   = std::ptrdiff_t;
+        using iterator_concept  = std::bidirectional_iterator_tag;
+
+        iterator() = default;
+        iterator(const Bitmap* b, std::size_t pos) : bits_(b), pos_(pos) {}
+
+        // The first set bit at or after `from`.
+        static std::size_t next_set(const Bitmap& b, std::size_t from) {
+            if (from >= b.size) return b.size;
+            std::size_t w = from / 64;
+            std::uint64_t word = b.words[w] & (~std::uint64_t{0} << (from % 64));
+            while (word == 0) {
+                if (++w == b.words.size()) return b.size;
+                word = b.words[w];
+            }
+            return w * 64 + std::countr_zero(word);
+        }
+
+        // The last set bit strictly before `before` (assumed to exist).
+        static std::size_t prev_set(const Bitmap& b, std::size_t before) {
+            std::size_t w = (before - 1) / 64;
+            std::uint64_t word = b.words[w] & (~std::uint64_t{0} >> (63 - (before - 1) % 64));
+            while (word == 0) word = b.words[--w];
+            return w * 64 + 63 - std::countl_zero(word);
+        }
+
+        std::size_t operator*() const { return pos_; }
+        iterator& operator++() { pos_ = next_set(*bits_, pos_ + 1); return *this; }
+        iterator operator++(int) { auto t = *this; ++*this; return t; }
+        iterator& operator--() { pos_ = prev_set(*bits_, pos_); return *this; }
+        iterator operator--(int) { auto t = *this; --*this; return t; }
+        bool operator==(const iterator& o) const { return pos_ == o.pos_; }
+    };
+
+    set_bits_view() = default;
+    explicit set_bits_view(const Bitmap& b) : bits_(&b) {}
+
+    iterator begin() const { return {bits_, iterator::next_set(*bits_, 0)}; }
+    iterator end() const { return {bits_, bits_->size}; }
+};
+
+// =============================================================================
+// 2. THE COLUMNAR STORE
+// =============================================================================
+using CategoryId = std::uint8_t;
+
+// Membership of each possible category id in a category predicate.
+using CategorySet = std::array<bool, 256>;
+
+// What a row of the store looks like when it is read: two plain values and a
+// view of the interned category string. Copying one costs nothing.
+struct SaleRef {
+    int amount;
+    CategoryId category_id;
+    std::string_view category;
+};
+
+class SalesColumns {
+public:
+    std::vector<int> amount;
+    std::vector<CategoryId> category;
+    Bitmap valid;
+
+    explicit SalesColumns(const std::vector<Sale>& sales) : valid(sales.size()) {
+        amount.reserve(sales.size());
+        category.reserve(sales.size());
+        for (std::size_t i = 0; i < sales.size(); ++i) {
+            amount.push_back(sales[i].amount);
+            category.push_back(intern(sales[i].category));
+            if (sales[i].valid) valid.set(i);
+        }
+    }
+
+    std::size_t size() const { return amount.size(); }
+    std::string_view category_name(CategoryId id) const { return dictionary_[id]; }
+    std::size_t category_count() const { return dictionary_.size(); }
+
+    // Runs a string predicate once per distinct category, and returns the
+    // membership table for the ids it accepted.
+    template <class Pred>
+    CategorySet categories_where(Pred pred) const {
+        CategorySet ids{};
+        for (std::size_t id = 0; id < dictionary_.size(); ++id)
+            ids[id] = std::invoke(pred, std::string_view(dictionary_[id]));
+        return ids;
+    }
+
+    // Valid rows whose category id is in `ids` (or NOT in it, when negate is set),
+    // produced word by word as an integer test over the category column.
+    Bitmap valid_where(const CategorySet& ids, bool negate = false) const {
+        Bitmap out(size());
+        const CategoryId* cat = category.data();
+        for (std::size_t w = 0; w < valid.words.size(); ++w) {
+            std::uint64_t live = valid.words[w], hit = 0;
+            std::size_t base = w * 64, lanes = std::min<std::size_t>(64, size() - base);
+            for (std::size_t l = 0; l < lanes; ++l)
+                hit |= std::uint64_t{ids[cat[base + l]] != negate} << l;
+            out.words[w] = live & hit;
+        }
+        return out;
+    }
+
+    SaleRef row(std::size_t i) const {
+        return {amount[i], category[i], dictionary_[category[i]]};
+    }
+
+    // A zero-copy range of the rows selected by a bitmap. The view refers to
+    // the bitmap, so a temporary one is rejected rather than left dangling.
+    auto rows(const Bitmap& selected) const {
+        return set_bits_view(selected)
+             | std::views::transform([this](std::size_t i) { return row(i); });
+    }
+    void rows(Bitmap&&) const = delete;
+
+private:
+    CategoryId intern(const std::string& name) {
+        auto it = std::ranges::find(dictionary_, name);
+        if (it != dictionary_.end()) return static_cast<CategoryId>(it - dictionary_.begin());
+        if (dictionary_.size() == 256) throw std::length_error("more than 256 categories");
+        dictionary_.push_back(name);
+        return static_cast<CategoryId>(dictionary_.size() - 1);
+    }
+
+    std::vector<std::string> dictionary_;     // A handful of entries; id = position
+};
+
+// =============================================================================
+// 3. MAIN EXECUTION
+// =============================================================================
+template <class F>
+double best_ms(F&& f, int reps = 5) {
+    double best = 1e300;
+    for (int i = 0; i < reps; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(t1 - t0).count());
+    }
+    return best;
+}
+
+int main() {
+    std::vector<Sale> sales = {
+        {100, "electronics", true}, {250, "clothing", true}, {50, "books", true},
+        {300, "electronics", true}, {75, "clothing", false}, {400, "books", true},
+        {100, "electronics", true}, {500, "electronics", true}, {200, "books", true},
+        {600, "electronics", false}, {800, "books", true}
+    };
+    SalesColumns cols(sales);
+
+    // === VIEWS PIPELINE, over the columns ===
+    // Same shape as ex_01.cpp: valid rows -> double the amount -> drop 1 ->
+    // take 10 -> reverse. The store is never copied; each stage sees SaleRefs.
+    auto pipeline = cols.rows(cols.valid)
+        | std::views::transform([](SaleRef s) { s.amount *= 2; return s; })
+        | std::views::drop(1)
+        | std::views::take(10)
+        | std::views::reverse;
+
+    std::cout << "Pipeline (columnar): ";
+    for (const SaleRef& s : pipeline) std::cout << s.category << ":" << s.amount << " ";
+    std::cout << "\n";
+
+    // === CATEGORY SPLIT ===
+    // The substring test from ex_01.cpp runs once per dictionary entry (three
+    // times here), not once per row.
+    auto is_elec = cols.categories_where([](std::string_view c) { return c.find("electronics") != c.npos; });
+    Bitmap elec = cols.valid_where(is_elec);
+    Bitmap other = cols.valid_where(is_elec, /*negate=*/true);
+
+    auto total_of = [&](const Bitmap& b) {
+        auto amounts = cols.rows(b) | std::views::transform([](SaleRef s) { return s.amount; });
+        return std::accumulate(amounts.begin(), amounts.end(), 0);
+    };
+    int elec_total = total_of(elec);
+    int other_total = total_of(other);
+
+    std::cout << "Categories interned: " << cols.category_count() << "\n";
+    std::cout << "Electronics: " << elec.count() << " sales, $" << elec_total << "\n";
+    std::cout << "Others:      " << other.count() << " sales, $" << other_total << "\n";
+
+    // === CHECK AGAINST THE ROW-ORIENTED VERSION ===
+    auto row_pipeline = sales
+        | std::views::filter([](const Sale& s) { return s.valid; })
+        | std::views::transform([](Sale s) { s.amount *= 2; return s; })
+        | std::views::drop(1)
+        | std::views::take(10)
+        | std::views::reverse;
+    bool ok = std::ranges::equal(row_pipeline, pipeline, [](const Sale& a, const SaleRef& b) {
+        return a.amount == b.amount && a.category == b.category;
+    });
+
+    // On a large table, time the electronics total both ways.
+    std::mt19937 gen(1);
+    const char* names[] = {"electronics", "clothing", "books", "home electronics", "garden"};
+    std::vector<Sale> big;
+    for (int i = 0; i < 2'000'000; ++i)
+        big.push_back({int(gen() % 1000), names[gen() % 5], gen() % 10 != 0});
+    SalesColumns big_cols(big);
+
+    auto row_total = [&] {
+        long long t = 0;
+        for (const Sale& s : big)
+            if (s.valid && s.category.find("electronics") != std::string::npos) t += s.amount;
+        return t;
+    };
+    auto col_total = [&] {
+        auto ids = big_cols.categories_where([](std::string_view c) { return c.find("electronics") != c.npos; });
+        Bitmap sel = big_cols.valid_where(ids);
+        long long t = 0;
+        for (std::size_t i : set_bits_view(sel)) t += big_cols.amount[i];
+        return t;
+    };
+    ok = ok && row_total() == col_total();
+
+    double r = best_ms([&] { volatile auto t = row_total(); (void)t; });
+    double c = best_ms([&] { volatile auto t = col_total(); (void)t; });
+    std::cout << "\nElectronics total over " << big.size() << " rows: row-wise " << r
+              << " ms, columnar " << c << " ms (" << r / c << "x)\n";
+    std::cout << "Results agree: " << (ok ? "YES" : "NO") << "\n";
+
+    return ok ? 0 : 1;
+}
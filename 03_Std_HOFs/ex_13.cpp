@@ -0,0 +1,334 @@
+/**
+ * E-commerce analytics — parallel sort, partition and top-k backends
+ *
+ * ex_01.cpp runs sort, stable_sort, partial_sort, nth_element, stable_partition
+ * and the heap family sequentially on std::vector<Sale>. Each of them is a
+ * comparison-based pass that also moves whole Sale objects (and their strings)
+ * around on every swap.
+ *
+ * This example provides a parallel layer behind those steps, built from plain
+ * std::thread workers over contiguous chunks:
+ * 1. `par_radix_sort`       — LSD radix sort on the 32-bit amount, one byte per
+ *                             pass, with per-thread histograms. It sorts
+ *                             (key, index) pairs and moves each Sale exactly
+ *                             once at the end. It is stable, so it replaces
+ *                             both sort and stable_sort, and make_heap +
+ *                             sort_heap as a way of ordering the data.
+ * 2. `par_stable_partition` — per-chunk counts, a prefix over the chunks, then a
+ *                             parallel scatter. Same order as stable_partition.
+ * 3. `par_top_k`            — each thread keeps its own k best in a bounded
+ *                             heap, and the k * threads candidates are
+ *                             finished with one small partial_sort. It answers
+ *                             what partial_sort and nth_element were used for.
+ *
+ * The benchmark reports speedup versus thread count for each size given on
+ * the command line (default 1M and 4M rows; pass 100000000 for the 100M case,
+ * which needs roughly 6 GB of memory).
+ *
+ *   Build : g++ -std=c++23 -O2 -pthread -o par_sales ex_13.cpp
+ *   Run   : ./par_sales [rows...]
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Sale {
+    int amount;
+    std::string category;
+    bool valid;
+};
+
+// =============================================================================
+// 1. CHUNKED PARALLEL LOOP
+// =============================================================================
+// Splits [0, n) into `threads` contiguous chunks and runs fn(chunk, first, last)
+// on each, the first chunk on the calling thread.
+template <class Fn>
+void parallel_chunks(std::size_t n, unsigned threads, Fn fn) {
+    threads = std::max(1u, threads);
+    std::size_t step = (n + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (unsigned c = 1; c < threads; ++c) {
+        std::size_t first = std::min(n, c * step), last = std::min(n, first + step);
+        workers.emplace_back(fn, c, first, last);
+    }
+    fn(0u, std::size_t{0}, std::min(n, step));
+    for (auto& w : workers) w.join();
+}
+
+// Maps an int to an unsigned key with the same order, so negative amounts sort
+// correctly; a descending sort simply complements the key.
+constexpr std::uint32_t sort_key(int amount, bool descending) {
+    std::uint32_t k = std::bit_cast<std::uint32_t>(amount) ^ 0x8000'0000u;
+    return descending ? ~k : k;
+}
+
+// =============================================================================
+// 2. PARALLEL RADIX SORT
+// =============================================================================
+// Stable sort of `sales` by amount. Each pass is:
+//   histogram (parallel) -> per-thread bucket offsets (serial, 256 * threads)
+//   -> scatter (parallel, each thread writes its own disjoint slots).
+// Passes whose byte is the same for every row are skipped.
+void par_radix_sort(std::vector<Sale>& sales, unsigned threads, bool descending = false) {
+    const std::size_t n = sales.size();
+    threads = std::max(1u, std::min<unsigned>(threads, n / 16384 + 1));
+
+    std::vector<std::uint32_t> key(n), key_tmp(n), idx(n), idx_tmp(n);
+    parallel_chunks(n, threads, [&](unsigned, std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            key[i] = sort_key(sales[i].amount, descending);
+            idx[i] = static_cast<std::uint32_t>(i);
+        }
+    });
+
+    std::vector<std::array<std::size_t, 256>> count(threads);
+    for (unsigned shift = 0; shift < 32; shift += 8) {
+        parallel_chunks(n, threads, [&](unsigned c, std::size_t first, std::size_t last) {
+            count[c].fill(0);
+            for (std::size_t i = first; i < last; ++i) ++count[c][key[i] >> shift & 0xFF];
+        });
+
+        // Turn counts into starting offsets: bucket-major, then chunk order,
+        // which is what keeps the sort stable.
+        std::size_t offset = 0;
+        bool trivial = false;
+        for (std::size_t d = 0; d < 256; ++d) {
+            std::size_t bucket = 0;
+            for (unsigned c = 0; c < threads; ++c) {
+                std::size_t here = count[c][d];
+                count[c][d] = offset;
+                offset += here;
+                bucket += here;
+            }
+            trivial = trivial || bucket == n;
+        }
+        if (trivial) continue;
+
+        parallel_chunks(n, threads, [&](unsigned c, std::size_t first, std::size_t last) {
+            auto& pos = count[c];
+            for (std::size_t i = first; i < last; ++i) {
+                std::size_t to = pos[key[i] >> shift & 0xFF]++;
+                key_tmp[to] = key[i];
+                idx_tmp[to] = idx[i];
+            }
+        });
+        key.swap(key_tmp);
+        idx.swap(idx_tmp);
+    }
+
+    // Move each Sale once, into its final slot.
+    std::vector<Sale> out(n);
+    parallel_chunks(n, threads, [&](unsigned, std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) out[i] = std::move(sales[idx[i]]);
+    });
+    sales.swap(out);
+}
+
+// =============================================================================
+// 3. PARALLEL STABLE PARTITION
+// =============================================================================
+// Moves the rows that satisfy `pred` to the front, keeping relative order on
+// both sides, and returns the size of the front part.
+template <class Pred>
+std::size_t par_stable_partition(std::vector<Sale>& sales, unsigned threads, Pred pred) {
+    const std::size_t n = sales.size();
+    threads = std::max(1u, std::min<unsigned>(threads, n / 16384 + 1));
+
+    // 1. Evaluate the predicate once per row and count per chunk.
+    std::vector<std::uint8_t> hit(n);
+    std::vector<std::size_t> yes(threads), start(threads);
+    parallel_chunks(n, threads, [&](unsigned c, std::size_t first, std::size_t last) {
+        std::size_t k = 0;
+        for (std::size_t i = first; i < last; ++i) k += hit[i] = std::invoke(pred, sales[i]);
+        yes[c] = k;
+        start[c] = first;
+    });
+
+    // 2. Chunk c writes its hits after all earlier chunks' hits, and its misses
+    //    after every hit plus all earlier chunks' misses.
+    std::size_t total_yes = std::reduce(yes.begin(), yes.end(), std::size_t{0});
+    std::vector<std::size_t> yes_at(threads), no_at(threads);
+    std::size_t y = 0, m = 0;
+    for (unsigned c = 0; c < threads; ++c) {
+        yes_at[c] = y;
+        no_at[c] = total_yes + m;
+        y += yes[c];
+        m += (c + 1 < threads ? start[c + 1] : n) - start[c] - yes[c];
+    }
+
+    // 3. Scatter.
+    std::vector<Sale> out(n);
+    parallel_chunks(n, threads, [&](unsigned c, std::size_t first, std::size_t last) {
+        std::size_t y = yes_at[c], m = no_at[c];
+        for (std::size_t i = first; i < last; ++i) out[hit[i] ? y++ : m++] = std::move(sales[i]);
+    });
+    sales.swap(out);
+    return total_yes;
+}
+
+// =============================================================================
+// 4. PARALLEL TOP-K
+// =============================================================================
+// Returns the indices of the k largest amounts (ties broken by lower index),
+// in descending order. Nothing in `sales` is moved.
+std::vector<std::size_t> par_top_k(const std::vector<Sale>& sales, std::size_t k, unsigned threads) {
+    const std::size_t n = sales.size();
+    k = std::min(k, n);
+    threads = std::max(1u, std::min<unsigned>(threads, n / 16384 + 1));
+
+    auto better = [&](std::size_t a, std::size_t b) {
+        return sales[a].amount != sales[b].amount ? sales[a].amount > sales[b].amount : a < b;
+    };
+
+    std::vector<std::vector<std::size_t>> local(threads);
+    parallel_chunks(n, threads, [&](unsigned c, std::size_t first, std::size_t last) {
+        // A heap of the chunk's k best so far, whose front is the worst of them;
+        // most rows are rejected by a single compare against that front.
+        auto& cand = local[c];
+        cand.reserve(k);
+        for (std::size_t i = first; i < last && cand.size() < k; ++i) cand.push_back(i);
+        std::make_heap(cand.begin(), cand.end(), better);
+        for (std::size_t i = first + cand.size(); i < last; ++i) {
+            if (k == 0 || !better(i, cand.front())) continue;
+            std::pop_heap(cand.begin(), cand.end(), better);
+            cand.back() = i;
+            std::push_heap(cand.begin(), cand.end(), better);
+        }
+    });
+
+    std::vector<std::size_t> all;
+    all.reserve(k * threads);
+    for (auto& cand : local) all.insert(all.end(), cand.begin(), cand.end());
+    std::partial_sort(all.begin(), all.begin() + k, all.end(), better);
+    all.resize(k);
+    return all;
+}
+
+// =============================================================================
+// 5. VERIFICATION AND BENCHMARK
+// =============================================================================
+std::vector<Sale> synthetic_sales(std::size_t n) {
+    static const char* names[] = {"electronics", "clothing", "books", "home", "garden", "toys"};
+    std::mt19937 gen(static_cast<unsigned>(n));
+    std::uniform_int_distribution<int> amount(0, 1'000'000);
+    std::vector<Sale> v;
+    v.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) v.push_back({amount(gen), names[gen() % 6], gen() % 16 != 0});
+    return v;
+}
+
+bool same(const std::vector<Sale>& a, const std::vector<Sale>& b) {
+    return std::ranges::equal(a, b, [](const Sale& x, const Sale& y) {
+        return x.amount == y.amount && x.category == y.category && x.valid == y.valid;
+    });
+}
+
+template <class F>
+double time_ms(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char** argv) {
+    auto is_elec = [](const Sale& s) { return s.category.find("electronics") != std::string::npos; };
+    auto desc = [](const Sale& a, const Sale& b) { return a.amount > b.amount; };
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+
+    // The small data set from ex_01.cpp, including a negative refund.
+    std::vector<Sale> sales = {
+        {100, "electronics", true}, {250, "clothing", true}, {50, "books", true},
+        {300, "electronics", true}, {75, "clothing", true}, {400, "books", true},
+        {100, "electronics", true}, {500, "electronics", true}, {-20, "books", true},
+        {600, "electronics", true}, {800, "books", true}
+    };
+
+    auto sorted = sales;
+    par_radix_sort(sorted, hw, /*descending=*/true);
+    std::cout << "Radix-sorted (desc): ";
+    for (const Sale& s : sorted) std::cout << s.amount << " ";
+
+    auto parted = sorted;
+    std::size_t n_elec = par_stable_partition(parted, hw, is_elec);
+    std::cout << "\nElectronics first:   ";
+    for (const Sale& s : parted) std::cout << s.category.substr(0, 4) << ":" << s.amount << " ";
+
+    auto top = par_top_k(sales, 3, hw);
+    std::cout << "\nTop-3 amounts:       ";
+    for (std::size_t i : top) std::cout << sales[i].amount << " ";
+    std::cout << "\n";
+
+    // Every backend must reproduce its sequential counterpart exactly.
+    bool ok = true;
+    std::vector<std::vector<Sale>> datasets{sales};
+    for (std::size_t n : {std::size_t{0}, std::size_t{1}, std::size_t{1000}, std::size_t{200'003}})
+        datasets.push_back(synthetic_sales(n));
+    for (const auto& data : datasets) {
+        for (unsigned t : {1u, 3u, hw}) {
+            auto want = data, got = data;
+            std::ranges::stable_sort(want, desc);
+            par_radix_sort(got, t, true);
+            ok = ok && same(want, got);
+
+            auto want_p = want, got_p = want;
+            auto split = std::ranges::stable_partition(want_p, is_elec);
+            std::size_t cut = par_stable_partition(got_p, t, is_elec);
+            ok = ok && same(want_p, got_p) && cut == std::size_t(split.begin() - want_p.begin());
+
+            std::size_t k = std::min<std::size_t>(10, data.size());
+            auto want_k = data;
+            std::ranges::partial_sort(want_k, want_k.begin() + k, desc);
+            auto got_k = par_top_k(data, k, t);
+            for (std::size_t i = 0; i < k; ++i) ok = ok && data[got_k[i]].amount == want_k[i].amount;
+        }
+    }
+    std::cout << "Electronics count: " << n_elec << ", backends agree with std: " << (ok ? "YES" : "NO") << "\n";
+
+    // Speedup versus thread count.
+    std::vector<std::size_t> sizes;
+    for (int i = 1; i < argc; ++i) sizes.push_back(std::strtoull(argv[i], nullptr, 10));
+    if (sizes.empty()) sizes = {1'000'000, 4'000'000};
+
+    std::vector<unsigned> counts;
+    for (unsigned t = 1; t < hw; t *= 2) counts.push_back(t);
+    counts.push_back(hw);
+
+    for (std::size_t n : sizes) {
+        const auto data = synthetic_sales(n);
+        std::cout << "\n=== " << n << " sales ===\n";
+
+        double base_sort = 0, base_part = 0, base_topk = 0;
+        {
+            auto a = data, b = data;
+            base_sort = time_ms([&] { std::ranges::stable_sort(a, desc); });
+            base_part = time_ms([&] { std::ranges::stable_partition(b, is_elec); });
+            auto c = data;
+            base_topk = time_ms([&] { std::ranges::partial_sort(c, c.begin() + 100, desc); });
+        }
+        std::cout << "std sequential: stable_sort " << base_sort << " ms, stable_partition "
+                  << base_part << " ms, partial_sort(100) " << base_topk << " ms\n";
+
+        for (unsigned t : counts) {
+            auto a = data, b = data;
+            double s = time_ms([&] { par_radix_sort(a, t, true); });
+            double p = time_ms([&] { par_stable_partition(b, t, is_elec); });
+            double k = time_ms([&] { volatile auto r = par_top_k(data, 100, t).size(); (void)r; });
+            std::cout << "threads " << t << ": radix " << s << " ms (" << base_sort / s << "x), partition "
+                      << p << " ms (" << base_part / p << "x), top-k " << k << " ms (" << base_topk / k << "x)\n";
+        }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,287 @@
+// This file revisits the clamp_view adaptor from ex_05.cpp for large sensor logs.
+//
+// ex_05.cpp's clamp_view::iterator is a plain input iterator: it has no
+// operator--, operator+= or operator[], and the view has no size(). So a
+// std::vector<double> source, which is contiguous, sized and random-access,
+// comes out of the adaptor as a single-pass range. Algorithms that need random
+// access (sort, binary search, nth_element, parallel chunking) no longer apply,
+// and the element-at-a-time std::clamp in operator* is all the compiler sees.
+//
+// This version keeps the same pipeline spelling and changes two things:
+//   1. The iterator forwards the traversal of the base: bidirectional and
+//      random-access operations exist exactly when the base iterator has them,
+//      and the view is sized (and const-iterable) when the base is.
+//   2. When the base is contiguous, the view also offers clamp_into(span), a
+//      bulk kernel that clamps 4 doubles per instruction with AVX2
+//      (2 with SSE2, scalar otherwise), and to_vector() built on it.
+//
+// Build : g++ -std=c++20 -O2 -mavx2 -o clamp_simd ex_14.cpp
+//         (drop -mavx2 to run the SSE2 path)
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define CLAMP_SIMD "AVX2"
+#elif defined(__SSE2__)
+#define CLAMP_SIMD "SSE2"
+#else
+#define CLAMP_SIMD "scalar"
+#endif
+
+// =============================================================================
+// 1. THE BULK KERNEL
+// =============================================================================
+// out[i] = std::clamp(in[i], lo, hi). max/min take their SECOND operand when
+// either is NaN, so putting the bounds first lets a NaN reading pass through,
+// exactly like std::clamp. `out` may alias `in`.
+inline void clamp_into(std::span<const double> in, std::span<double> out, double lo, double hi)
+{
+    const std::size_t n = std::min(in.size(), out.size());
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256d vlo = _mm256_set1_pd(lo), vhi = _mm256_set1_pd(hi);
+    for (; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_loadu_pd(in.data() + i);
+        _mm256_storeu_pd(out.data() + i, _mm256_min_pd(vhi, _mm256_max_pd(vlo, x)));
+    }
+#elif defined(__SSE2__)
+    const __m128d vlo = _mm_set1_pd(lo), vhi = _mm_set1_pd(hi);
+    for (; i + 2 <= n; i += 2) {
+        __m128d x = _mm_loadu_pd(in.data() + i);
+        _mm_storeu_pd(out.data() + i, _mm_min_pd(vhi, _mm_max_pd(vlo, x)));
+    }
+#endif
+    for (; i < n; ++i) out[i] = std::clamp(in[i], lo, hi);
+}
+
+// =============================================================================
+// 2. THE VIEW
+// =============================================================================
+template <std::ranges::view V>
+class clamp_view : public std::ranges::view_interface<clamp_view<V>> {
+private:
+    V base_ = V();
+    double min_val_{0.0};
+    double max_val_{0.0};
+
+    // One iterator template serves begin() and begin() const.
+    template <bool Const>
+    class iterator {
+        using Base = std::conditional_t<Const, const V, V>;
+        using It   = std::ranges::iterator_t<Base>;
+
+        It current_{};
+        double min_val_{0.0};
+        double max_val_{0.0};
+
+    public:
+        // The strongest category the base supports, capped at random-access:
+        // operator* returns a computed value, so the view is never contiguous.
+        using iterator_concept =
+            std::conditional_t<std::random_access_iterator<It>, std::random_access_iterator_tag,
+            std::conditional_t<std::bidirectional_iterator<It>, std::bidirectional_iterator_tag,
+            std::conditional_t<std::forward_iterator<It>, std::forward_iterator_tag,
+                               std::input_iterator_tag>>>;
+        using value_type      = double;
+        using difference_type = std::ranges::range_difference_t<Base>;
+
+        iterator() = default;
+        iterator(It current, double min_val, double max_val)
+            : current_(std::move(current)), min_val_(min_val), max_val_(max_val) {}
+        // non-const -> const conversion, as the standard views provide
+        iterator(iterator<!Const> other) requires Const && std::convertible_to<std::ranges::iterator_t<V>, It>
+            : current_(std::move(other.current_)), min_val_(other.min_val_), max_val_(other.max_val_) {}
+
+        const It& base() const { return current_; }
+
+        double operator*() const {
+            return std::clamp(static_cast<double>(*current_), min_val_, max_val_);
+        }
+
+        iterator& operator++() { ++current_; return *this; }
+        void operator++(int) requires (!std::forward_iterator<It>) { ++current_; }
+        iterator operator++(int) requires std::forward_iterator<It> { auto t = *this; ++current_; return t; }
+
+        iterator& operator--() requires std::bidirectional_iterator<It> { --current_; return *this; }
+        iterator operator--(int) requires std::bidirectional_iterator<It> { auto t = *this; --current_; return t; }
+
+        iterator& operator+=(difference_type n) requires std::random_access_iterator<It> { current_ += n; return *this; }
+        iterator& operator-=(difference_type n) requires std::random_access_iterator<It> { current_ -= n; return *this; }
+        double operator[](difference_type n) const requires std::random_access_iterator<It> { return *(*this + n); }
+
+        friend iterator operator+(iterator i, difference_type n) requires std::random_access_iterator<It> { return i += n; }
+        friend iterator operator+(difference_type n, iterator i) requires std::random_access_iterator<It> { return i += n; }
+        friend iterator operator-(iterator i, difference_type n) requires std::random_access_iterator<It> { return i -= n; }
+        friend difference_type operator-(const iterator& a, const iterator& b)
+            requires std::sized_sentinel_for<It, It> { return a.current_ - b.current_; }
+
+        friend bool operator==(const iterator& a, const iterator& b) requires std::equality_comparable<It> {
+            return a.current_ == b.current_;
+        }
+        friend auto operator<=>(const iterator& a, const iterator& b) requires std::random_access_iterator<It> {
+            return a.current_ <=> b.current_;
+        }
+
+        template <bool> friend class iterator;
+    };
+
+    // The end is an iterator when the base is common, otherwise a sentinel
+    // wrapper that compares against the base sentinel.
+    template <bool Const>
+    struct sentinel {
+        std::ranges::sentinel_t<std::conditional_t<Const, const V, V>> end_{};
+        friend bool operator==(const iterator<Const>& it, const sentinel& s) { return it.base() == s.end_; }
+    };
+
+    template <bool Const>
+    auto make_end(auto&& base) const {
+        if constexpr (std::ranges::common_range<decltype(base)>)
+            return iterator<Const>(std::ranges::end(base), min_val_, max_val_);
+        else
+            return sentinel<Const>{std::ranges::end(base)};
+    }
+
+public:
+    clamp_view() = default;
+    clamp_view(V base, double min_val, double max_val)
+        : base_(std::move(base)), min_val_(min_val), max_val_(max_val) {}
+
+    auto begin() { return iterator<false>(std::ranges::begin(base_), min_val_, max_val_); }
+    auto end()   { return make_end<false>(base_); }
+
+    auto begin() const requires std::ranges::range<const V> {
+        return iterator<true>(std::ranges::begin(base_), min_val_, max_val_);
+    }
+    auto end() const requires std::ranges::range<const V> { return make_end<true>(base_); }
+
+    auto size()       requires std::ranges::sized_range<V>       { return std::ranges::size(base_); }
+    auto size() const requires std::ranges::sized_range<const V> { return std::ranges::size(base_); }
+
+    // -------------------------------------------------------------------------
+    // Contiguous sources: clamp the whole range in bulk.
+    // -------------------------------------------------------------------------
+    // Writes min(size(), out.size()) values and returns how many were written.
+    std::size_t clamp_into(std::span<double> out) const
+        requires std::ranges::contiguous_range<const V>
+              && std::same_as<std::ranges::range_value_t<const V>, double>
+    {
+        std::span<const double> in(std::ranges::data(base_), std::ranges::size(base_));
+        ::clamp_into(in, out, min_val_, max_val_);
+        return std::min(in.size(), out.size());
+    }
+
+    std::vector<double> to_vector() const
+        requires std::ranges::contiguous_range<const V>
+              && std::same_as<std::ranges::range_value_t<const V>, double>
+    {
+        std::vector<double> out(std::ranges::size(base_));
+        clamp_into(out);
+        return out;
+    }
+};
+
+template <class R>
+clamp_view(R&&, double, double) -> clamp_view<std::views::all_t<R>>;
+
+// =============================================================================
+// 3. PIPELINE ADAPTOR SETUP (unchanged from ex_05.cpp)
+// =============================================================================
+namespace custom_views {
+
+    struct clamp_adaptor_closure {
+        double min_val;
+        double max_val;
+
+        template <std::ranges::viewable_range R>
+        friend auto operator|(R&& r, const clamp_adaptor_closure& closure) {
+            return clamp_view(std::forward<R>(r), closure.min_val, closure.max_val);
+        }
+    };
+
+    inline auto clamp(double min_val, double max_val) {
+        return clamp_adaptor_closure{min_val, max_val};
+    }
+}
+
+// The properties the old view lost, checked at compile time.
+using vec_clamp = decltype(std::declval<std::vector<double>&>() | custom_views::clamp(0.0, 5.0));
+static_assert(std::ranges::random_access_range<vec_clamp>);
+static_assert(std::ranges::random_access_range<const vec_clamp>);
+static_assert(std::ranges::sized_range<vec_clamp>);
+static_assert(std::ranges::common_range<vec_clamp>);
+using iota_clamp = decltype(std::views::iota(0) | custom_views::clamp(0.0, 5.0));
+static_assert(std::ranges::random_access_range<iota_clamp> && !std::ranges::sized_range<iota_clamp>);
+
+// =============================================================================
+// 4. MAIN EXECUTION
+// =============================================================================
+int main() {
+    std::vector<double> voltage_readings = {-1.5, 0.2, 3.5, 6.2, 2.0, -0.4, 5.0};
+
+    auto clamped = voltage_readings | custom_views::clamp(0.0, 5.0);
+    auto safe_readings = clamped | std::views::filter([](double v) { return v > 0.0; });
+
+    std::cout << "Clamped & Filtered Safe Readings (0.0V to 5.0V):\n";
+    for (double v : safe_readings) std::cout << v << "V ";
+    std::cout << "\n";
+
+    auto newest_first = clamped | std::views::reverse;   // needs bidirectional
+    std::cout << "size=" << clamped.size() << " clamped[3]=" << clamped[3]
+              << " back=" << clamped.back() << " reversed front=" << newest_first.front() << "\n";
+
+    auto bulk = clamped.to_vector();
+    bool ok = std::ranges::equal(bulk, clamped);
+
+    // -- Benchmark: 10M readings, three ways to materialise the clamped data ---
+    const std::size_t n = 10'000'000;
+    std::mt19937_64 gen(42);
+    std::normal_distribution<double> volts(2.5, 2.0);
+    std::vector<double> readings(n);
+    for (double& v : readings) v = volts(gen);
+
+    using clock = std::chrono::steady_clock;
+    auto best_ms = [](auto&& f) {
+        double best = 1e300;
+        for (int r = 0; r < 5; ++r) {
+            auto t0 = clock::now();
+            f();
+            best = std::min(best, std::chrono::duration<double, std::milli>(clock::now() - t0).count());
+        }
+        return best;
+    };
+
+    std::vector<double> a, b(n), c(n);
+    auto view = readings | custom_views::clamp(0.0, 5.0);
+
+    // (a) The element-wise way ex_05.cpp's input range allows: push_back per value.
+    double t_push = best_ms([&] {
+        a.clear();
+        for (double v : view) a.push_back(v);
+    });
+    // (b) Random access and size() let the standard algorithm write into place.
+    double t_copy = best_ms([&] { std::ranges::copy(view, b.begin()); });
+    // (c) The bulk kernel.
+    double t_bulk = best_ms([&] { view.clamp_into(c); });
+
+    ok = ok && a == b && b == c;
+
+    std::cout << "\n" << n << " readings, best of 5 (" << CLAMP_SIMD << ")\n"
+              << "  element-wise push_back : " << t_push << " ms\n"
+              << "  ranges::copy (sized)   : " << t_copy << " ms\n"
+              << "  clamp_into             : " << t_bulk << " ms\n"
+              << (ok ? "all three agree\n" : "RESULTS DIFFER\n");
+
+    return ok ? 0 : 1;
+}
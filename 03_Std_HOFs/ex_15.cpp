@@ -0,0 +1,291 @@
+// This file revisits curve_view and pass_rate from ex_06.cpp for term-sized
+// grade runs (millions of exam records).
+//
+// In ex_06.cpp the curve_view iterator is capped at forward_iterator_tag, and
+// the view has neither size() nor a const begin(). So pass_rate must count the
+// students itself, a const view cannot be iterated, and a contiguous
+// std::vector<double> source loses random access as soon as it is curved.
+//
+// This version changes three things and keeps the pipeline spelling:
+//   1. The iterator forwards the base's category up to random-access, and the
+//      view is sized and const-iterable when its base is.
+//   2. The generic pass_rate takes the student count from size() when the range
+//      is sized, and counts with std::ranges::count_if.
+//   3. A pass_rate overload for a curve_view over contiguous doubles evaluates
+//      min(100, score + bonus) >= threshold for 4 scores per instruction (AVX2,
+//      2 with SSE2) and counts the passes in the same pass.
+//
+// Build : g++ -std=c++20 -O2 -mavx2 -o curve_simd ex_15.cpp
+//         (drop -mavx2 to run the SSE2 path)
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define CURVE_SIMD "AVX2"
+#elif defined(__SSE2__)
+#define CURVE_SIMD "SSE2"
+#else
+#define CURVE_SIMD "scalar"
+#endif
+
+// =============================================================================
+// 1. CUSTOM VIEW ADAPTOR (Lazy Execution)
+// =============================================================================
+template <std::ranges::view V>
+class curve_view : public std::ranges::view_interface<curve_view<V>> {
+private:
+    V base_ = V();          // The underlying range/view
+    double bonus_{0.0};     // The curve points to add
+
+    template <bool Const>
+    class iterator {
+        using Base = std::conditional_t<Const, const V, V>;
+        using It   = std::ranges::iterator_t<Base>;
+
+        It current_{};
+        double bonus_{0.0};
+
+    public:
+        // As strong as the base iterator, up to random-access, and single-pass
+        // over a single-pass base. The scores are computed, so it is never
+        // contiguous.
+        using iterator_concept =
+            std::conditional_t<std::random_access_iterator<It>, std::random_access_iterator_tag,
+            std::conditional_t<std::bidirectional_iterator<It>, std::bidirectional_iterator_tag,
+            std::conditional_t<std::forward_iterator<It>, std::forward_iterator_tag,
+                               std::input_iterator_tag>>>;
+        using value_type      = double;
+        using difference_type = std::ranges::range_difference_t<Base>;
+
+        iterator() = default;
+        iterator(It current, double bonus) : current_(std::move(current)), bonus_(bonus) {}
+        iterator(iterator<!Const> other) requires Const && std::convertible_to<std::ranges::iterator_t<V>, It>
+            : current_(std::move(other.current_)), bonus_(other.bonus_) {}
+
+        const It& base() const { return current_; }
+
+        // Adds the bonus and caps at 100.0 only when an element is read.
+        double operator*() const { return std::min(100.0, static_cast<double>(*current_) + bonus_); }
+
+        iterator& operator++() { ++current_; return *this; }
+        iterator operator++(int) { auto t = *this; ++current_; return t; }
+
+        iterator& operator--() requires std::bidirectional_iterator<It> { --current_; return *this; }
+        iterator operator--(int) requires std::bidirectional_iterator<It> { auto t = *this; --current_; return t; }
+
+        iterator& operator+=(difference_type n) requires std::random_access_iterator<It> { current_ += n; return *this; }
+        iterator& operator-=(difference_type n) requires std::random_access_iterator<It> { current_ -= n; return *this; }
+        double operator[](difference_type n) const requires std::random_access_iterator<It> { return *(*this + n); }
+
+        friend iterator operator+(iterator i, difference_type n) requires std::random_access_iterator<It> { return i += n; }
+        friend iterator operator+(difference_type n, iterator i) requires std::random_access_iterator<It> { return i += n; }
+        friend iterator operator-(iterator i, difference_type n) requires std::random_access_iterator<It> { return i -= n; }
+        friend difference_type operator-(const iterator& a, const iterator& b)
+            requires std::sized_sentinel_for<It, It> { return a.current_ - b.current_; }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a.current_ == b.current_; }
+        friend auto operator<=>(const iterator& a, const iterator& b) requires std::random_access_iterator<It> {
+            return a.current_ <=> b.current_;
+        }
+
+        template <bool> friend class iterator;
+    };
+
+public:
+    curve_view() = default;
+    curve_view(V base, double bonus) : base_(std::move(base)), bonus_(bonus) {}
+
+    // ex_06.cpp's end() is an iterator too, so the base must be a common range.
+    auto begin() { return iterator<false>(std::ranges::begin(base_), bonus_); }
+    auto end()   { return iterator<false>(std::ranges::end(base_), bonus_); }
+    auto begin() const requires std::ranges::forward_range<const V> { return iterator<true>(std::ranges::begin(base_), bonus_); }
+    auto end()   const requires std::ranges::forward_range<const V> { return iterator<true>(std::ranges::end(base_), bonus_); }
+
+    auto size()       requires std::ranges::sized_range<V>       { return std::ranges::size(base_); }
+    auto size() const requires std::ranges::sized_range<const V> { return std::ranges::size(base_); }
+
+    const V& base() const { return base_; }
+    double bonus() const { return bonus_; }
+};
+
+template <class R>
+curve_view(R&&, double) -> curve_view<std::views::all_t<R>>;
+
+namespace custom_views {
+    struct curve_closure {
+        double bonus;
+
+        template <std::ranges::viewable_range R>
+        friend auto operator|(R&& r, const curve_closure& closure) {
+            return curve_view(std::forward<R>(r), closure.bonus);
+        }
+    };
+
+    inline auto curve(double bonus) { return curve_closure{bonus}; }
+}
+
+using vec_curve = decltype(std::declval<const std::vector<double>&>() | custom_views::curve(0));
+static_assert(std::ranges::random_access_range<const vec_curve>);
+static_assert(std::ranges::sized_range<vec_curve>);
+
+// =============================================================================
+// 2. CUSTOM RANGE ALGORITHM (Eager Execution)
+// =============================================================================
+namespace custom_algos {
+
+    // Number of curved scores at or above the threshold, over contiguous raw
+    // scores. Each lane computes min(100, score + bonus) exactly as the view
+    // does; min_pd returns its second operand for NaN, i.e. 100, like std::min.
+    inline std::size_t count_curved_passes(std::span<const double> raw, double bonus, double threshold) {
+        std::size_t i = 0, passed = 0;
+#if defined(__AVX2__)
+        const __m256d vb = _mm256_set1_pd(bonus), vt = _mm256_set1_pd(threshold), cap = _mm256_set1_pd(100.0);
+        __m256i acc = _mm256_setzero_si256();           // 4 lane counters (a pass adds -(-1))
+        for (; i + 4 <= raw.size(); i += 4) {
+            __m256d curved = _mm256_min_pd(_mm256_add_pd(_mm256_loadu_pd(raw.data() + i), vb), cap);
+            acc = _mm256_sub_epi64(acc, _mm256_castpd_si256(_mm256_cmp_pd(curved, vt, _CMP_GE_OQ)));
+        }
+        alignas(32) std::int64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        passed = std::size_t(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+#elif defined(__SSE2__)
+        const __m128d vb = _mm_set1_pd(bonus), vt = _mm_set1_pd(threshold), cap = _mm_set1_pd(100.0);
+        __m128i acc = _mm_setzero_si128();
+        for (; i + 2 <= raw.size(); i += 2) {
+            __m128d curved = _mm_min_pd(_mm_add_pd(_mm_loadu_pd(raw.data() + i), vb), cap);
+            acc = _mm_sub_epi64(acc, _mm_castpd_si128(_mm_cmpge_pd(curved, vt)));
+        }
+        alignas(16) std::int64_t lanes[2];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        passed = std::size_t(lanes[0] + lanes[1]);
+#endif
+        for (; i < raw.size(); ++i) passed += std::min(100.0, raw[i] + bonus) >= threshold;
+        return passed;
+    }
+
+    // Any input range. A sized range supplies the student count; otherwise the
+    // elements are counted while they are tested.
+    template <std::ranges::input_range R>
+    double pass_rate(R&& range, double pass_threshold) {
+        std::size_t total = 0, passed = 0;
+        if constexpr (std::ranges::sized_range<R>) {
+            total  = std::ranges::size(range);
+            passed = std::size_t(std::ranges::count_if(range, [=](double s) { return s >= pass_threshold; }));
+        } else {
+            for (double score : range) {
+                ++total;
+                passed += score >= pass_threshold;
+            }
+        }
+        if (total == 0) return 0.0;
+        return (static_cast<double>(passed) / total) * 100.0;
+    }
+
+    // A curve over contiguous doubles: one SIMD pass over the raw scores.
+    template <class V>
+        requires std::ranges::contiguous_range<const V>
+              && std::same_as<std::ranges::range_value_t<const V>, double>
+    double pass_rate(const curve_view<V>& curved, double pass_threshold) {
+        std::span<const double> raw(std::ranges::data(curved.base()), std::ranges::size(curved.base()));
+        if (raw.empty()) return 0.0;
+        return (static_cast<double>(count_curved_passes(raw, curved.bonus(), pass_threshold)) / raw.size()) * 100.0;
+    }
+    template <class V>
+        requires std::ranges::contiguous_range<const V>
+              && std::same_as<std::ranges::range_value_t<const V>, double>
+    double pass_rate(curve_view<V>& curved, double pass_threshold) {
+        return pass_rate(std::as_const(curved), pass_threshold);
+    }
+}
+
+// ex_06.cpp's pass_rate, kept for the benchmark.
+template <std::ranges::input_range R>
+double pass_rate_counting(R&& range, double pass_threshold) {
+    int total_students = 0;
+    int passed_students = 0;
+    for (double score : range) {
+        total_students++;
+        if (score >= pass_threshold) passed_students++;
+    }
+    if (total_students == 0) return 0.0;
+    return (static_cast<double>(passed_students) / total_students) * 100.0;
+}
+
+// =============================================================================
+// 3. MAIN EXECUTION
+// =============================================================================
+int main() {
+    std::vector<double> exam_scores = {45.0, 82.5, 95.0, 58.0, 49.5, 99.0};
+    double passing_grade = 60.0;
+
+    const auto final_grades_view = exam_scores | custom_views::curve(12.0);   // const now iterates
+
+    std::cout << "--- CURVED SCORES ---\n";
+    for (double score : final_grades_view) std::cout << score << " ";
+    std::cout << "\nsize=" << final_grades_view.size() << " [2]=" << final_grades_view[2]
+              << " back=" << final_grades_view.back() << "\n";
+    std::cout << "Curved Pass Rate: " << custom_algos::pass_rate(final_grades_view, passing_grade) << "%\n";
+
+    bool ok = custom_algos::pass_rate(final_grades_view, passing_grade)
+           == pass_rate_counting(final_grades_view, passing_grade);
+
+    // Every code path on odd sizes and awkward values (NaN, at the threshold, over 100).
+    std::mt19937_64 gen(2024);
+    std::uniform_real_distribution<double> score(0.0, 100.0);
+    for (std::size_t n = 0; n < 40; ++n) {
+        std::vector<double> v(n);
+        for (double& x : v) x = score(gen);
+        if (n > 3) { v[1] = 48.0; v[2] = std::numeric_limits<double>::quiet_NaN(); v[3] = 130.0; }
+        auto cv = v | custom_views::curve(12.0);
+        ok &= custom_algos::pass_rate(cv, 60.0) == pass_rate_counting(cv, 60.0);
+        ok &= custom_algos::pass_rate(cv | std::views::take(n), 60.0) == pass_rate_counting(cv, 60.0);
+    }
+
+    // -- Benchmark: a term run of 10M records --------------------------------
+    const std::size_t n = 10'000'000;
+    std::vector<double> term(n);
+    for (double& x : term) x = score(gen);
+    auto curved = term | custom_views::curve(7.5);
+
+    using clock = std::chrono::steady_clock;
+    auto best_ms = [](auto&& f, double& out) {
+        double best = 1e300;
+        for (int r = 0; r < 5; ++r) {
+            auto t0 = clock::now();
+            out = f();
+            best = std::min(best, std::chrono::duration<double, std::milli>(clock::now() - t0).count());
+        }
+        return best;
+    };
+
+    double r_count = 0, r_sized = 0, r_simd = 0;
+    auto generic = curved | std::views::filter([](double) { return true; });   // hides the size, like ex_06.cpp
+    double t_count = best_ms([&] { return pass_rate_counting(curved, 60.0); }, r_count);
+    double t_sized = best_ms([&] { return custom_algos::pass_rate(curved | std::views::take(n), 60.0); }, r_sized);
+    double t_simd  = best_ms([&] { return custom_algos::pass_rate(curved, 60.0); }, r_simd);
+    double r_gen = custom_algos::pass_rate(generic, 60.0);
+    ok &= r_count == r_sized && r_sized == r_simd && r_simd == r_gen;
+
+    std::cout << "\n" << n << " records, best of 5 (" << CURVE_SIMD << ")\n"
+              << "  ex_06 pass_rate (counts students)  : " << t_count << " ms\n"
+              << "  sized pass_rate (count_if)         : " << t_sized << " ms\n"
+              << "  curve_view overload (SIMD)         : " << t_simd << " ms\n"
+              << "  pass rate " << r_simd << "%  " << (ok ? "all versions agree" : "RESULTS DIFFER") << "\n";
+
+    return ok ? 0 : 1;
+}
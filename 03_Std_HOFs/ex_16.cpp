@@ -0,0 +1,344 @@
+// This file makes the custom RANGE ALGORITHM from ex_04.cpp parallel.
+//
+// ex_04.cpp's `longest_streak_if` scans left to right and carries one piece of
+// state (the current run) from each element to the next, so it cannot be split
+// as written. The fix is to summarise a SEGMENT of the range instead of a
+// position in it:
+//
+//     run_summary { size, prefix, suffix, best, best_pos }
+//
+// prefix/suffix are the runs touching the segment's two ends, and best is the
+// longest run inside it (the segment is "all true" when prefix == size).
+// Two adjacent summaries combine in O(1): the longest run of the joined
+// segment is the left best, the right best, or left.suffix + right.prefix,
+// which crosses the seam. That combine is associative, so chunks can be
+// summarised on separate threads and folded in order.
+//
+// Three entry points, all returning the POSITION and the LENGTH of the longest
+// streak (the earliest one if several tie):
+//   1. longest_streak_if(r, pred)           - sequential, any input range
+//   2. par_longest_streak_if(r, pred, n)    - n threads, random-access sized ranges
+//   3. longest_streak(bits, [n])            - bit-packed input (std::vector<bool>,
+//                                             std::bitset, raw uint64_t words):
+//      a whole 64-bit word is summarised with countr_one/countl_one, and only
+//      words that mix ones and zeros need a closer look.
+//
+// Build : g++ -std=c++20 -O2 -pthread -o streaks ex_16.cpp
+// Run   : ./streaks [entries]      (default 200'000'000)
+
+#include <algorithm>
+#include <bit>
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <ranges>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+// --------------------------------------------------------------------
+// 1. The result and the segment monoid
+// --------------------------------------------------------------------
+
+// position is the index of the streak's first element; 0 when length is 0.
+struct streak {
+    std::ptrdiff_t position = 0;
+    std::ptrdiff_t length   = 0;
+    bool operator==(const streak&) const = default;
+};
+
+struct run_summary {
+    std::ptrdiff_t size = 0;
+    std::ptrdiff_t prefix = 0;     // run starting at the first element
+    std::ptrdiff_t suffix = 0;     // run ending at the last element
+    std::ptrdiff_t best = 0;       // longest run anywhere in the segment
+    std::ptrdiff_t best_pos = 0;   // where it starts, relative to the segment
+
+    bool all() const { return prefix == size; }
+
+    // `a` covers the elements immediately before `b`.
+    friend run_summary combine(const run_summary& a, const run_summary& b) {
+        run_summary r;
+        r.size   = a.size + b.size;
+        r.prefix = a.all() ? a.size + b.prefix : a.prefix;
+        r.suffix = b.all() ? b.size + a.suffix : b.suffix;
+
+        // Candidates in position order, so a strict > keeps the earliest.
+        r.best = a.best;
+        r.best_pos = a.best_pos;
+        if (const auto seam = a.suffix + b.prefix; seam > r.best) {
+            r.best = seam;
+            r.best_pos = a.size - a.suffix;
+        }
+        if (b.best > r.best) {
+            r.best = b.best;
+            r.best_pos = a.size + b.best_pos;
+        }
+        return r;
+    }
+
+    streak result() const { return {best > 0 ? best_pos : 0, best}; }
+};
+
+// --------------------------------------------------------------------
+// 2. Sequential and parallel over any predicate
+// --------------------------------------------------------------------
+
+// ex_04.cpp's loop, extended to track the prefix and where runs start.
+template <std::input_iterator It, std::sentinel_for<It> S, class Pred>
+run_summary summarize(It first, S last, Pred& pred) {
+    run_summary s;
+    std::ptrdiff_t current = 0;
+    bool in_prefix = true;
+    for (; first != last; ++first, ++s.size) {
+        if (std::invoke(pred, *first)) {
+            current += 1;
+            if (current > s.best) { s.best = current; s.best_pos = s.size + 1 - current; }
+        } else {
+            if (in_prefix) s.prefix = current;
+            in_prefix = false;
+            current = 0;
+        }
+    }
+    if (in_prefix) s.prefix = current;
+    s.suffix = current;
+    return s;
+}
+
+template <std::ranges::input_range R,
+          std::indirect_unary_predicate<std::ranges::iterator_t<R>> Pred>
+constexpr streak longest_streak_if(R&& r, Pred pred) {
+    return summarize(std::ranges::begin(r), std::ranges::end(r), pred).result();
+}
+
+// threads == 0 means one per hardware thread.
+template <std::ranges::random_access_range R,
+          std::indirect_unary_predicate<std::ranges::iterator_t<R>> Pred>
+    requires std::ranges::sized_range<R>
+streak par_longest_streak_if(R&& r, Pred pred, unsigned threads = 0) {
+    const auto first = std::ranges::begin(r);
+    const std::size_t n = std::ranges::size(r);
+
+    // Below this size the threads cost more than the scan itself.
+    constexpr std::size_t min_chunk = 1 << 16;
+    if (n < 2 * min_chunk) return longest_streak_if(r, pred);
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = unsigned(std::min<std::size_t>(threads, n / min_chunk));
+
+    std::vector<run_summary> parts(threads);
+    std::vector<std::thread> workers;
+    const std::size_t step = (n + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            const std::size_t b = std::min(n, t * step), e = std::min(n, b + step);
+            Pred local = pred;                            // each thread owns its predicate
+            parts[t] = summarize(first + b, first + e, local);
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    run_summary total;
+    for (const auto& p : parts) total = combine(total, p);
+    return total.result();
+}
+
+// --------------------------------------------------------------------
+// 3. Bit-packed input: 64 predicate results per word
+// --------------------------------------------------------------------
+// Bit i lives in words[i / 64] at bit (i % 64), which is how std::bitset and
+// libstdc++'s std::vector<bool> lay bits out.
+
+inline run_summary summarize_word(std::uint64_t w, unsigned bits) {
+    if (bits < 64) w &= (std::uint64_t(1) << bits) - 1;
+    run_summary s;
+    s.size = bits;
+    if (w == 0) return s;
+    s.prefix = std::countr_one(w);
+    s.suffix = std::countl_one(w << (64 - bits));
+    if (s.prefix == s.size) {                      // every bit set
+        s.best = s.size;
+        return s;
+    }
+    // Mixed word: hop from run to run, lowest (earliest) bits first.
+    for (unsigned pos = 0; w != 0;) {
+        const unsigned gap = std::countr_zero(w);
+        pos += gap;
+        w >>= gap;
+        const unsigned run = std::countr_one(w);
+        if (std::ptrdiff_t(run) > s.best) { s.best = run; s.best_pos = pos; }
+        pos += run;
+        w = run == 64 ? 0 : w >> run;
+    }
+    return s;
+}
+
+inline run_summary summarize_words(std::span<const std::uint64_t> words, std::size_t nbits) {
+    run_summary total;
+    for (std::size_t k = 0; k < words.size() && nbits > 0; ++k) {
+        const unsigned bits = unsigned(std::min<std::size_t>(64, nbits));
+        const std::uint64_t w = words[k];
+        // The two common cases need no summary at all.
+        if (bits == 64 && w == ~std::uint64_t(0) && total.all()) {
+            total.size += 64; total.prefix += 64; total.suffix += 64;
+            if (total.suffix > total.best) { total.best = total.suffix; total.best_pos = total.size - total.suffix; }
+        } else if (bits == 64 && w == 0 && !total.all()) {
+            total.size += 64; total.suffix = 0;
+        } else {
+            total = combine(total, summarize_word(w, bits));
+        }
+        nbits -= bits;
+    }
+    return total;
+}
+
+inline streak longest_streak(std::span<const std::uint64_t> words, std::size_t nbits, unsigned threads = 1) {
+    nbits = std::min(nbits, words.size() * 64);
+    const std::size_t nwords = (nbits + 63) / 64;
+    constexpr std::size_t min_words = 1 << 14;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = unsigned(std::clamp<std::size_t>(nwords / min_words, 1, threads));
+    if (threads == 1) return summarize_words(words, nbits).result();
+
+    // Chunks are whole words, so only the last chunk can end mid-word.
+    std::vector<run_summary> parts(threads);
+    std::vector<std::thread> workers;
+    const std::size_t step = (nwords + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            const std::size_t b = std::min(nwords, t * step), e = std::min(nwords, b + step);
+            const std::size_t bits = std::min(nbits, e * 64) - std::min(nbits, b * 64);
+            parts[t] = summarize_words(words.subspan(b, e - b), bits);
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    run_summary total;
+    for (const auto& p : parts) total = combine(total, p);
+    return total.result();
+}
+
+// std::vector<bool> has no portable word access, so its bits are packed into
+// words first. Callers that scan the same bits repeatedly should keep them
+// packed and use the span overload.
+inline std::vector<std::uint64_t> pack_bits(const std::vector<bool>& v) {
+    std::vector<std::uint64_t> words((v.size() + 63) / 64);
+    for (std::size_t i = 0; i < v.size(); ++i)
+        words[i / 64] |= std::uint64_t(v[i]) << (i % 64);
+    return words;
+}
+
+inline streak longest_streak(const std::vector<bool>& v, unsigned threads = 1) {
+    return longest_streak(pack_bits(v), v.size(), threads);
+}
+
+// std::bitset: no word access in the standard, so copy 64 bits at a time.
+template <std::size_t N>
+streak longest_streak(const std::bitset<N>& bs, unsigned threads = 1) {
+    std::vector<std::uint64_t> words((N + 63) / 64);
+    const std::bitset<N> low(~std::uint64_t(0));
+    std::bitset<N> rest = bs;
+    for (auto& w : words) {
+        w = (rest & low).to_ullong();
+        rest >>= 64;
+    }
+    return longest_streak(words, N, threads);
+}
+
+// --------------------------------------------------------------------
+// Real-world use: workout day logs, and an uptime bitmap
+// --------------------------------------------------------------------
+
+struct DayLog {
+    std::string day;
+    bool workout_done;
+};
+
+std::ostream& operator<<(std::ostream& os, const streak& s) {
+    return os << s.length << " starting at " << s.position;
+}
+
+int main(int argc, char** argv) {
+    std::vector<DayLog> week{
+        {"Mon", true}, {"Tue", true}, {"Wed", false}, {"Thu", true},
+        {"Fri", true}, {"Sat", true}, {"Sun", true},
+    };
+    auto done = [](const DayLog& d) { return d.workout_done; };
+    auto s = longest_streak_if(week, done);
+    std::cout << "Longest workout streak: " << s.length << " days, from " << week[s.position].day << "\n";
+    auto m = longest_streak_if(week, std::not_fn(done));
+    std::cout << "Longest missed streak: " << m.length << " days, on " << week[m.position].day << "\n";
+
+    // Every version against every other, on random inputs of awkward sizes.
+    bool ok = s == streak{3, 4} && m == streak{2, 1};
+    std::mt19937_64 gen(99);
+    for (std::size_t n : {0u, 1u, 63u, 64u, 65u, 127u, 1000u, 200'000u, 300'001u}) {
+        for (double p : {0.0, 0.5, 0.97, 1.0}) {
+            std::bernoulli_distribution coin(p);
+            std::vector<char> v(n);
+            std::vector<bool> vb(n);
+            for (std::size_t i = 0; i < n; ++i) { v[i] = coin(gen); vb[i] = v[i]; }
+            auto is_set = [](char c) { return c != 0; };
+            const streak want = longest_streak_if(v, is_set);
+            ok &= par_longest_streak_if(v, is_set, 4) == want
+               && longest_streak(vb) == want && longest_streak(vb, 4) == want;
+        }
+    }
+    std::bitset<200> bs;
+    for (std::size_t i = 70; i < 150; ++i) bs.set(i);
+    bs.reset(100);
+    ok &= longest_streak(bs) == streak{101, 49};
+
+    // Large enough that four threads each get several chunks of min_words.
+    {
+        const std::size_t nbig = 4 * (std::size_t(1) << 14) * 64 + 12'345;
+        std::bernoulli_distribution coin(0.9995);
+        std::vector<char> v(nbig);
+        std::vector<bool> vb(nbig);
+        for (std::size_t i = 0; i < nbig; ++i) { v[i] = coin(gen); vb[i] = v[i]; }
+        const auto words = pack_bits(vb);
+        const streak want = longest_streak_if(v, [](char c) { return c != 0; });
+        ok &= longest_streak(words, nbig, 4) == want && longest_streak(words, nbig, 3) == want;
+    }
+
+    // -- Benchmark: uptime history, one entry per second ---------------------
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200'000'000;
+    std::vector<char> up(n);
+    std::vector<bool> up_bits(n);
+    std::bernoulli_distribution outage(1e-5);        // rare outages: long runs, mostly all-ones words
+    for (std::size_t i = 0; i < n; ++i) { up[i] = !outage(gen); up_bits[i] = up[i]; }
+    const auto up_words = pack_bits(up_bits);        // packed once, as an uptime store would keep them
+
+    using clock = std::chrono::steady_clock;
+    auto ms = [](auto t0) { return std::chrono::duration<double, std::milli>(clock::now() - t0).count(); };
+    auto is_up = [](char c) { return c != 0; };
+
+    auto t0 = clock::now();
+    const streak seq = longest_streak_if(up, is_up);
+    const double t_seq = ms(t0);
+    t0 = clock::now();
+    const streak par = par_longest_streak_if(up, is_up);
+    const double t_par = ms(t0);
+    t0 = clock::now();
+    const streak bits = longest_streak(up_words, n);
+    const double t_bits = ms(t0);
+    t0 = clock::now();
+    const streak bits_par = longest_streak(up_words, n, 0);
+    const double t_bits_par = ms(t0);
+    ok &= seq == par && par == bits && bits == bits_par && longest_streak(up_bits) == seq;
+
+    std::cout << "\n" << n << " entries, " << std::thread::hardware_concurrency() << " hardware threads\n"
+              << "  longest uptime: " << seq << "\n"
+              << "  sequential (bytes)   : " << t_seq << " ms\n"
+              << "  parallel   (bytes)   : " << t_par << " ms\n"
+              << "  bit-packed           : " << t_bits << " ms\n"
+              << "  bit-packed, parallel : " << t_bits_par << " ms\n"
+              << (ok ? "all versions agree\n" : "RESULTS DIFFER\n");
+    return ok ? 0 : 1;
+}
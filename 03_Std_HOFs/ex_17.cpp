@@ -0,0 +1,251 @@
+// GradeFilterView from ex_03.cpp without std::function, plus two indexed modes.
+//
+// ex_03.cpp stores filter_view<V, std::function<bool(const Student&)>>, so
+// every element test is an indirect call the compiler cannot inline, for a
+// predicate that is one integer comparison. Here the predicate is a concrete
+// type, grade_at_least, and the view comes in three modes chosen by a tag:
+//
+//   GradeFilterView v(students, 80);                   // scan: filter_view<V, grade_at_least>
+//   GradeFilterView v(students, 80, sorted_by_grade);  // source sorted by ascending grade:
+//                                                      // begin() binary-searches, and the view
+//                                                      // is a random-access, sized suffix
+//   GradeFilterView v(students, 80, cached_bitmap);    // any order: the first begin() tests every
+//                                                      // student once into a bitmap, and later
+//                                                      // iterations hop from set bit to set bit
+//
+// As with filter_view, whose begin() is cached too, the indexed modes assume
+// the grades do not change while the view is in use; invalidate() drops the
+// bitmap if they do.
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <ranges>
+#include <string>
+#include <vector>
+
+struct Student {
+    std::string name;
+    int grade;
+};
+
+// 1. The predicate as a concrete type: inlinable, and it can be read back.
+struct grade_at_least {
+    int min_grade = 0;
+    bool operator()(const Student& s) const { return s.grade >= min_grade; }
+};
+
+enum class grade_index { scan, sorted, bitmap };
+
+struct sorted_by_grade_t { explicit sorted_by_grade_t() = default; };
+struct cached_bitmap_t   { explicit cached_bitmap_t() = default; };
+inline constexpr sorted_by_grade_t sorted_by_grade{};
+inline constexpr cached_bitmap_t   cached_bitmap{};
+
+// 2. Custom View
+template <std::ranges::view V, grade_index Index = grade_index::scan>
+class GradeFilterView;
+
+// 2a. Scan: a plain filter_view with the concrete predicate.
+template <std::ranges::view V>
+class GradeFilterView<V, grade_index::scan>
+    : public std::ranges::view_interface<GradeFilterView<V, grade_index::scan>> {
+private:
+    std::ranges::filter_view<V, grade_at_least> filtered_base;
+
+public:
+    GradeFilterView() = default;
+    GradeFilterView(V base, int min_grade) : filtered_base(std::move(base), grade_at_least{min_grade}) {}
+
+    auto begin() { return std::ranges::begin(filtered_base); }
+    auto end()   { return std::ranges::end(filtered_base); }
+};
+
+// 2b. Sorted by ascending grade: the qualifying students are a suffix.
+template <std::ranges::view V>
+    requires std::ranges::random_access_range<V>
+class GradeFilterView<V, grade_index::sorted>
+    : public std::ranges::view_interface<GradeFilterView<V, grade_index::sorted>> {
+private:
+    V base_ = V();
+    int min_grade_ = 0;
+
+public:
+    GradeFilterView() = default;
+    GradeFilterView(V base, int min_grade, sorted_by_grade_t)
+        : base_(std::move(base)), min_grade_(min_grade) {}
+
+    auto begin() const requires std::ranges::random_access_range<const V> {
+        return std::ranges::lower_bound(base_, min_grade_, std::ranges::less{}, &Student::grade);
+    }
+    auto end() const requires std::ranges::random_access_range<const V> { return std::ranges::end(base_); }
+};
+
+// 2c. Any order: a bitmap of qualifying positions, built on first use.
+template <std::ranges::view V>
+    requires std::ranges::random_access_range<V> && std::ranges::sized_range<V>
+class GradeFilterView<V, grade_index::bitmap>
+    : public std::ranges::view_interface<GradeFilterView<V, grade_index::bitmap>> {
+private:
+    V base_ = V();
+    grade_at_least pred_{};
+    std::vector<std::uint64_t> bits_;     // bit i set: student i qualifies
+    std::size_t count_ = 0;
+    bool built_ = false;
+
+    void build() {
+        const std::size_t n = std::ranges::size(base_);
+        bits_.assign((n + 63) / 64 + 1, 0);              // +1: a zero word after the last
+        auto first = std::ranges::begin(base_);
+        for (std::size_t i = 0; i < n; ++i)
+            bits_[i / 64] |= std::uint64_t(pred_(first[i])) << (i % 64);
+        count_ = 0;
+        for (auto w : bits_) count_ += std::popcount(w);
+        built_ = true;
+    }
+
+    // First set bit at or after i, or size() when there is none.
+    std::size_t next_set(std::size_t i) const {
+        const std::size_t n = std::ranges::size(base_);
+        if (i >= n) return n;
+        std::size_t k = i / 64;
+        std::uint64_t w = bits_[k] & (~std::uint64_t(0) << (i % 64));
+        while (w == 0) {
+            if (++k * 64 >= n) return n;
+            w = bits_[k];
+        }
+        return std::min(n, k * 64 + std::countr_zero(w));
+    }
+
+public:
+    class iterator {
+        const GradeFilterView* view_ = nullptr;
+        std::size_t i_ = 0;
+
+    public:
+        using value_type      = std::ranges::range_value_t<V>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        iterator(const GradeFilterView* v, std::size_t i) : view_(v), i_(i) {}
+
+        decltype(auto) operator*() const { return std::ranges::begin(view_->base_)[i_]; }
+        iterator& operator++() { i_ = view_->next_set(i_ + 1); return *this; }
+        iterator operator++(int) { auto t = *this; ++*this; return t; }
+        bool operator==(const iterator& o) const { return i_ == o.i_; }
+
+        std::size_t index() const { return i_; }          // position in the source
+    };
+
+    GradeFilterView() = default;
+    GradeFilterView(V base, int min_grade, cached_bitmap_t)
+        : base_(std::move(base)), pred_{min_grade} {}
+
+    iterator begin() {
+        if (!built_) build();
+        return {this, next_set(0)};
+    }
+    iterator end() { return {this, std::ranges::size(base_)}; }
+
+    std::size_t size() {
+        if (!built_) build();
+        return count_;
+    }
+    void invalidate() { built_ = false; }
+};
+
+// 3. Deduction Guides
+template <typename R>
+GradeFilterView(R&&, int) -> GradeFilterView<std::views::all_t<R>, grade_index::scan>;
+template <typename R>
+GradeFilterView(R&&, int, sorted_by_grade_t) -> GradeFilterView<std::views::all_t<R>, grade_index::sorted>;
+template <typename R>
+GradeFilterView(R&&, int, cached_bitmap_t) -> GradeFilterView<std::views::all_t<R>, grade_index::bitmap>;
+
+// ex_03.cpp's storage, kept for comparison.
+template <std::ranges::view V>
+class ErasedGradeFilterView : public std::ranges::view_interface<ErasedGradeFilterView<V>> {
+    std::ranges::filter_view<V, std::function<bool(const Student&)>> filtered_base;
+
+public:
+    ErasedGradeFilterView(V base, int min_grade)
+        : filtered_base(std::move(base), [min_grade](const Student& s) { return s.grade >= min_grade; }) {}
+    auto begin() { return std::ranges::begin(filtered_base); }
+    auto end()   { return std::ranges::end(filtered_base); }
+};
+template <typename R>
+ErasedGradeFilterView(R&&, int) -> ErasedGradeFilterView<std::views::all_t<R>>;
+
+int main() {
+    std::vector<Student> students = {
+        {"Charlie", 95}, {"Alice", 82}, {"Bob", 55}, {"Diana", 70}
+    };
+
+    // 4. Projection: sort by name, then filter with each mode
+    std::ranges::sort(students, std::ranges::less{}, &Student::name);
+
+    GradeFilterView honors_students(students, 80);
+    std::cout << "Honors Students (Sorted by Name):\n";
+    for (const auto& s : honors_students) std::cout << " - " << s.name << ": " << s.grade << "\n";
+
+    GradeFilterView honors_bitmap(students, 80, cached_bitmap);
+    std::cout << "Bitmap mode: " << honors_bitmap.size() << " honors students\n";
+
+    auto by_grade = students;
+    std::ranges::sort(by_grade, std::ranges::less{}, &Student::grade);
+    GradeFilterView honors_sorted(by_grade, 80, sorted_by_grade);
+    std::cout << "Sorted mode (by grade):";
+    for (const auto& s : honors_sorted) std::cout << " " << s.name;
+    std::cout << " [size " << honors_sorted.size() << ", lowest " << honors_sorted[0].grade << "]\n";
+
+    auto names = [](auto&& view) {
+        std::vector<std::string> out;
+        for (const auto& s : view) out.push_back(s.name);
+        std::ranges::sort(out);
+        return out;
+    };
+    bool ok = names(honors_students) == names(honors_bitmap)
+           && names(honors_students) == names(honors_sorted);
+
+    // 5. Benchmark: a large cohort, the honors list iterated repeatedly
+    const std::size_t n = 2'000'000;
+    const int passes = 20;
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> grade(0, 100);
+    std::vector<Student> cohort(n);
+    for (auto& s : cohort) s.grade = grade(gen);
+    auto cohort_sorted = cohort;
+    std::ranges::stable_sort(cohort_sorted, std::ranges::less{}, &Student::grade);
+
+    using clock = std::chrono::steady_clock;
+    auto run = [&](auto&& view, long long& sum) {
+        auto t0 = clock::now();
+        sum = 0;
+        for (int p = 0; p < passes; ++p)
+            for (const auto& s : view) sum += s.grade;
+        return std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+    };
+
+    // The fresh view is built inside each timing, so caching costs are included.
+    long long s_erased, s_scan, s_bitmap, s_sorted;
+    double t_erased = run(ErasedGradeFilterView(cohort, 90), s_erased);
+    double t_scan   = run(GradeFilterView(cohort, 90), s_scan);
+    double t_bitmap = run(GradeFilterView(cohort, 90, cached_bitmap), s_bitmap);
+    double t_sorted = run(GradeFilterView(cohort_sorted, 90, sorted_by_grade), s_sorted);
+    ok &= s_erased == s_scan && s_scan == s_bitmap && s_bitmap == s_sorted;
+
+    std::cout << "\n" << n << " students, grade >= 90, " << passes << " iterations each\n"
+              << "  std::function filter_view (ex_03) : " << t_erased << " ms\n"
+              << "  grade_at_least filter_view        : " << t_scan << " ms\n"
+              << "  cached bitmap                     : " << t_bitmap << " ms\n"
+              << "  sorted, binary-searched begin()   : " << t_sorted << " ms\n"
+              << (ok ? "all modes agree\n" : "RESULTS DIFFER\n");
+
+    return ok ? 0 : 1;
+}
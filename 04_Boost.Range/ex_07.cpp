@@ -0,0 +1,307 @@
+/* DEMO - A numerically stable, mergeable stats() algorithm for Boost.Range */
+//
+// The stats() algorithm in ex_05.cpp accumulates sum and sum of squares and
+// takes sd = sqrt(sq/n - mean*mean). On a long stream of readings with a large
+// offset (volts around a 1e6 bias, nanoseconds since the epoch, ...) the two
+// terms are huge and nearly equal, so their difference is mostly rounding
+// error. The variance can even come out negative, which makes the sd NaN. It
+// also divides by zero on an empty range, and it prints instead of returning.
+//
+// Here the accumulator is Welford's update, extended to the third moment
+// (Pébay 2008), so skewness comes from the same single pass:
+//   running_stats::push(x)        - one sample, O(1), no catastrophic cancellation
+//   running_stats::merge(other)   - Chan et al.'s pairwise combine, so partial
+//                                   results from separate threads can be merged
+//   stats(range)                  - any single-pass Boost.Range
+//   stats(range, threads)         - random-access ranges only: one chunk per
+//                                   thread, then a merge of the partial results
+// Both overloads return a stats_result. An empty range gives count == 0 and
+// NaN for everything else.
+//
+// Build: g++ -std=c++20 -O2 -pthread -o ex_07 ex_07.cpp
+
+#include <algorithm>   // std::clamp, std::min, std::max
+#include <chrono>
+#include <cmath>       // std::sqrt
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_adaptor.hpp>
+#include <boost/iterator/iterator_categories.hpp>
+#include <boost/range/adaptor/filtered.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator_range.hpp>
+
+// ── ring_buffer and the clamped adaptor, as in ex_05.cpp ──────────────────
+template <typename T>
+class ring_buffer {
+public:
+    class iterator : public boost::iterator_adaptor<
+              iterator, boost::counting_iterator<std::size_t>, const T>
+    {
+    public:
+        iterator() = default;
+        iterator(const ring_buffer* b, std::size_t i)
+            : iterator::iterator_adaptor_(boost::counting_iterator<std::size_t>(i)),
+              buf(b) {}
+
+    private:
+        friend class boost::iterator_core_access;
+
+        const T& dereference() const {
+            return buf->data[(buf->head + *this->base()) % buf->cap];
+        }
+
+        const ring_buffer* buf = nullptr;
+    };
+
+    using const_iterator = iterator;
+
+    explicit ring_buffer(std::size_t c) : data(c), cap(c) {}
+
+    void push_back(T v) {
+        data[(head + sz) % cap] = std::move(v);
+        if (sz < cap) ++sz;
+        else          head = (head + 1) % cap;
+    }
+
+    iterator begin() const { return {this, 0}; }
+    iterator end()   const { return {this, sz}; }
+
+private:
+    std::vector<T> data;
+    std::size_t    head = 0, sz = 0, cap;
+};
+
+namespace adaptors {
+
+template <typename It, typename T>
+class clamp_iterator
+    : public boost::iterator_adaptor<clamp_iterator<It, T>, It, T, boost::use_default, T>
+{
+public:
+    clamp_iterator() = default;
+    clamp_iterator(It it, T lo, T hi)
+        : clamp_iterator::iterator_adaptor_(it), lo(lo), hi(hi) {}
+
+private:
+    friend class boost::iterator_core_access;
+
+    T dereference() const { return std::clamp<T>(*this->base(), lo, hi); }
+
+    T lo{}, hi{};
+};
+
+template <typename T>
+struct clamp_holder { T lo, hi; };
+
+template <typename T>
+clamp_holder<T> clamped(T lo, T hi) { return {lo, hi}; }
+
+template <typename Range, typename T>
+auto operator|(const Range& r, const clamp_holder<T>& h) {
+    using It = decltype(boost::begin(r));
+    return boost::make_iterator_range(
+        clamp_iterator<It, T>(boost::begin(r), h.lo, h.hi),
+        clamp_iterator<It, T>(boost::end(r),   h.lo, h.hi));
+}
+
+} // namespace adaptors
+
+// ── Custom algorithm: stats, single pass and mergeable ────────────────────
+struct stats_result {
+    std::size_t count = 0;
+    double min, max, mean;
+    double variance;          // population variance, as ex_05.cpp's std
+    double sample_variance;   // divides by n - 1
+    double stddev;
+    double skewness;          // population skewness g1
+};
+
+class running_stats {
+public:
+    void push(double x) {
+        const double n1 = double(n);
+        ++n;
+        const double delta   = x - m1;
+        const double delta_n = delta / double(n);
+        const double term1   = delta * delta_n * n1;
+        m1 += delta_n;
+        m3 += term1 * delta_n * (double(n) - 2) - 3 * delta_n * m2;
+        m2 += term1;
+        lo = std::min(lo, x);
+        hi = std::max(hi, x);
+    }
+
+    // Combines the moments of two disjoint samples.
+    void merge(const running_stats& o) {
+        if (o.n == 0) return;
+        if (n == 0) { *this = o; return; }
+        const double na = double(n), nb = double(o.n), nt = na + nb;
+        const double delta = o.m1 - m1;
+        m3 += o.m3 + delta * delta * delta * na * nb * (na - nb) / (nt * nt)
+                   + 3 * delta * (na * o.m2 - nb * m2) / nt;
+        m2 += o.m2 + delta * delta * na * nb / nt;
+        m1 += delta * nb / nt;
+        n  += o.n;
+        lo = std::min(lo, o.lo);
+        hi = std::max(hi, o.hi);
+    }
+
+    stats_result result() const {
+        constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+        if (n == 0) return {0, nan, nan, nan, nan, nan, nan, nan};
+        const double nd  = double(n);
+        const double var = m2 / nd;
+        return {n, lo, hi, m1, var,
+                n > 1 ? m2 / (nd - 1) : nan,
+                std::sqrt(var),
+                m2 > 0 ? std::sqrt(nd) * m3 / std::pow(m2, 1.5) : 0.0};
+    }
+
+private:
+    std::size_t n = 0;
+    double m1 = 0, m2 = 0, m3 = 0;     // mean and central moment sums
+    double lo =  std::numeric_limits<double>::infinity();
+    double hi = -std::numeric_limits<double>::infinity();
+};
+
+template <typename Range>
+stats_result stats(const Range& r)
+{
+    running_stats acc;
+    for (double x : r) acc.push(x);
+    return acc.result();
+}
+
+template <typename Range>
+concept random_access_boost_range = std::is_convertible_v<
+    typename boost::iterator_traversal<decltype(boost::begin(std::declval<const Range&>()))>::type,
+    boost::random_access_traversal_tag>;
+
+// threads == 0 means one per hardware thread.
+template <random_access_boost_range Range>
+stats_result stats(const Range& r, unsigned threads)
+{
+    const auto first = boost::begin(r);
+    const std::size_t n = std::size_t(boost::end(r) - first);
+
+    // Below this size the threads cost more than the pass itself.
+    constexpr std::size_t min_chunk = 1 << 15;
+    if (n < 2 * min_chunk) return stats(r);
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = unsigned(std::min<std::size_t>(threads, n / min_chunk));
+
+    std::vector<running_stats> partial(threads);
+    std::vector<std::thread> workers;
+    const std::size_t step = (n + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            const std::size_t b = std::min(n, t * step), e = std::min(n, b + step);
+            running_stats acc;
+            for (auto it = first + b, last = first + e; it != last; ++it) acc.push(*it);
+            partial[t] = acc;
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    for (unsigned t = 1; t < threads; ++t) partial[0].merge(partial[t]);
+    return partial[0].result();
+}
+
+void print(const stats_result& s)
+{
+    std::cout << "count=" << s.count << "\nmin=" << s.min << "\nmax=" << s.max
+              << "\nmean=" << s.mean << "\nstd=" << s.stddev
+              << "\nskew=" << s.skewness << '\n';
+}
+
+// ex_05.cpp's formula, for comparison.
+template <typename Range>
+double naive_sd(const Range& r)
+{
+    double sum = 0, sq = 0;
+    std::size_t n = 0;
+    for (double x : r) { sum += x; sq += x * x; ++n; }
+    const double mean = sum / n;
+    return std::sqrt(sq / n - mean * mean);
+}
+
+// ── Demo ──────────────────────────────────────────────────────────────────
+int main() {
+    ring_buffer<double> rb(5);
+    for (double v : {3, -2, 10, 25, 7, 8, -5})
+        rb.push_back(v);
+
+    auto cl   = rb | adaptors::clamped(0.0, 15.0);
+    auto pipe = cl | boost::adaptors::filtered([](double x) { return x > 0; });
+
+    print(stats(pipe));                        // filtered: forward only, sequential
+    bool ok = stats(pipe).count == 4;   // 10 15 7 8; the clamped -5 is filtered out
+
+    // The clamped ring_buffer view stays random-access, so it can be split.
+    ok &= stats(cl, 4).count == stats(cl).count;
+
+    std::vector<double> empty;
+    std::cout << "\nempty: count=" << stats(empty).count << " mean=" << stats(empty).mean << '\n';
+    ok &= stats(empty).count == 0;
+
+    // Precision: 10M readings of 1e9 + N(0, 0.01). True sd is about 0.01.
+    std::mt19937_64 gen(7);
+    std::normal_distribution<double> noise(0.0, 0.01);
+    std::vector<double> readings(10'000'000);
+    for (double& x : readings) x = 1e9 + noise(gen);
+
+    long double ref_mean = 0, ref_m2 = 0;
+    for (double x : readings) ref_mean += x;
+    ref_mean /= readings.size();
+    for (double x : readings) ref_m2 += (x - ref_mean) * (x - ref_mean);
+    const double ref_sd = double(std::sqrt(ref_m2 / readings.size()));
+
+    using clock = std::chrono::steady_clock;
+    auto ms = [](auto t0) { return std::chrono::duration<double, std::milli>(clock::now() - t0).count(); };
+
+    auto t0 = clock::now();
+    const double nsd = naive_sd(readings);
+    const double t_naive = ms(t0);
+    t0 = clock::now();
+    const stats_result seq = stats(readings);
+    const double t_seq = ms(t0);
+    t0 = clock::now();
+    const stats_result par = stats(readings, 0);
+    const double t_par = ms(t0);
+
+    std::cout.precision(6);
+    std::cout << "\n10M readings around 1e9, two-pass reference sd = " << ref_sd << '\n'
+              << "  ex_05 formula   sd = " << nsd << "  (" << t_naive << " ms)\n"
+              << "  Welford         sd = " << seq.stddev << "  skew = " << seq.skewness
+              << "  (" << t_seq << " ms)\n"
+              << "  parallel merge  sd = " << par.stddev << "  skew = " << par.skewness
+              << "  (" << t_par << " ms)\n";
+
+    const auto close = [](double a, double b) { return std::abs(a - b) <= 1e-6 * std::abs(b); };
+    ok &= close(seq.stddev, ref_sd) && close(par.stddev, ref_sd) && seq.count == par.count
+       && seq.min == par.min && seq.max == par.max;
+
+    // Merging shards of any size must match one pass over everything.
+    running_stats a, b, all;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        const double x = std::pow(double(i % 37), 1.7);
+        (i < 123 ? a : b).push(x);
+        all.push(x);
+    }
+    a.merge(b);
+    ok &= close(a.result().variance, all.result().variance)
+       && close(a.result().skewness, all.result().skewness);
+
+    std::cout << (ok ? "\nall checks passed\n" : "\nCHECK FAILED\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,308 @@
+/* DEMO - The clamped adaptor with a bulk SIMD path for contiguous ranges */
+//
+// adaptors::clamp_iterator in ex_05.cpp already inherits the traversal of its
+// base, so `vector | clamped(lo, hi)` is random-access. What it cannot do is
+// clamp more than one element per dereference. When the source is contiguous
+// (std::vector, std::array, a raw array), the adaptor here returns a
+// contiguous_clamped_range instead:
+//   * it is still an iterator_range of clamp_iterator, over const T* rather
+//     than the container's iterator, so every Boost.Range adaptor and
+//     algorithm applies and random access and boost::size are preserved
+//   * it also has clamp_into(span), which clamps the whole source with AVX2
+//     min/max, 4 doubles or 8 floats per instruction (SSE2 or scalar on
+//     other targets)
+// Non-contiguous sources (the ring_buffer, filtered ranges) take the
+// element-wise path from ex_05.cpp unchanged.
+//
+// Build: g++ -std=c++20 -O2 -mavx2 -o ex_08 ex_08.cpp
+
+#include <algorithm>   // std::clamp, std::min, std::max
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_adaptor.hpp>
+#include <boost/range/adaptor/filtered.hpp>
+#include <boost/range/algorithm/copy.hpp>
+#include <boost/range/algorithm/equal.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <boost/range/size.hpp>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// ── ring_buffer, as in ex_05.cpp (a non-contiguous source) ────────────────
+template <typename T>
+class ring_buffer {
+public:
+    class iterator : public boost::iterator_adaptor<
+              iterator, boost::counting_iterator<std::size_t>, const T>
+    {
+    public:
+        iterator() = default;
+        iterator(const ring_buffer* b, std::size_t i)
+            : iterator::iterator_adaptor_(boost::counting_iterator<std::size_t>(i)),
+              buf(b) {}
+
+    private:
+        friend class boost::iterator_core_access;
+
+        const T& dereference() const {
+            return buf->data[(buf->head + *this->base()) % buf->cap];
+        }
+
+        const ring_buffer* buf = nullptr;
+    };
+
+    using const_iterator = iterator;
+
+    explicit ring_buffer(std::size_t c) : data(c), cap(c) {}
+
+    void push_back(T v) {
+        data[(head + sz) % cap] = std::move(v);
+        if (sz < cap) ++sz;
+        else          head = (head + 1) % cap;
+    }
+
+    iterator begin() const { return {this, 0}; }
+    iterator end()   const { return {this, sz}; }
+
+private:
+    std::vector<T> data;
+    std::size_t    head = 0, sz = 0, cap;
+};
+
+// ── Bulk kernels ──────────────────────────────────────────────────────────
+//
+// The bounds go first: max/min return their second operand when either is
+// NaN, so a NaN reading passes through, as it does through std::clamp.
+// Each kernel returns its width -- elements per vector instruction, 1 for
+// the scalar fallback, 0 for the generic loop -- so callers can check which
+// overload they reached.
+namespace kernels {
+
+inline std::size_t clamp_into(std::span<const double> in, std::span<double> out, double lo, double hi)
+{
+    const std::size_t n = std::min(in.size(), out.size());
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256d vlo = _mm256_set1_pd(lo), vhi = _mm256_set1_pd(hi);
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(out.data() + i,
+            _mm256_min_pd(vhi, _mm256_max_pd(vlo, _mm256_loadu_pd(in.data() + i))));
+#elif defined(__SSE2__)
+    const __m128d vlo = _mm_set1_pd(lo), vhi = _mm_set1_pd(hi);
+    for (; i + 2 <= n; i += 2)
+        _mm_storeu_pd(out.data() + i,
+            _mm_min_pd(vhi, _mm_max_pd(vlo, _mm_loadu_pd(in.data() + i))));
+#endif
+    for (; i < n; ++i) out[i] = std::clamp(in[i], lo, hi);
+#if defined(__AVX2__)
+    return 4;
+#elif defined(__SSE2__)
+    return 2;
+#else
+    return 1;
+#endif
+}
+
+inline std::size_t clamp_into(std::span<const float> in, std::span<float> out, float lo, float hi)
+{
+    const std::size_t n = std::min(in.size(), out.size());
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 vlo = _mm256_set1_ps(lo), vhi = _mm256_set1_ps(hi);
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(out.data() + i,
+            _mm256_min_ps(vhi, _mm256_max_ps(vlo, _mm256_loadu_ps(in.data() + i))));
+#elif defined(__SSE2__)
+    const __m128 vlo = _mm_set1_ps(lo), vhi = _mm_set1_ps(hi);
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_ps(out.data() + i,
+            _mm_min_ps(vhi, _mm_max_ps(vlo, _mm_loadu_ps(in.data() + i))));
+#endif
+    for (; i < n; ++i) out[i] = std::clamp(in[i], lo, hi);
+#if defined(__AVX2__)
+    return 8;
+#elif defined(__SSE2__)
+    return 4;
+#else
+    return 1;
+#endif
+}
+
+// Other arithmetic types: the compiler is left to vectorise this loop.
+template <typename T>
+std::size_t clamp_into(std::span<const T> in, std::span<T> out, T lo, T hi)
+{
+    const std::size_t n = std::min(in.size(), out.size());
+    for (std::size_t i = 0; i < n; ++i) out[i] = std::clamp(in[i], lo, hi);
+    return 0;
+}
+
+} // namespace kernels
+
+// ── Custom adaptor: clamped ───────────────────────────────────────────────
+namespace adaptors {
+
+template <typename It, typename T>
+class clamp_iterator
+    : public boost::iterator_adaptor<clamp_iterator<It, T>, It, T, boost::use_default, T>
+{
+public:
+    clamp_iterator() = default;
+    clamp_iterator(It it, T lo, T hi)
+        : clamp_iterator::iterator_adaptor_(it), lo(lo), hi(hi) {}
+
+private:
+    friend class boost::iterator_core_access;
+
+    T dereference() const { return std::clamp<T>(*this->base(), lo, hi); }
+
+    T lo{}, hi{};
+};
+
+// The element-wise range, plus the bulk path over the underlying array.
+template <typename T>
+class contiguous_clamped_range
+    : public boost::iterator_range<clamp_iterator<const T*, T>>
+{
+    using base_range = boost::iterator_range<clamp_iterator<const T*, T>>;
+
+public:
+    contiguous_clamped_range(const T* first, std::size_t n, T lo, T hi)
+        : base_range(clamp_iterator<const T*, T>(first, lo, hi),
+                     clamp_iterator<const T*, T>(first + n, lo, hi)),
+          src(first, n), lo(lo), hi(hi) {}
+
+    // Writes min(size, out.size()) values and returns how many were written.
+    std::size_t clamp_into(std::span<T> out) const {
+        kernel(out);
+        return std::min(src.size(), out.size());
+    }
+
+    // Width of the kernel clamp_into reaches (see kernels above).
+    std::size_t lanes() const { return kernel({}); }
+
+private:
+    // No explicit template arguments: the double / float overloads must be
+    // able to win over the generic template.
+    std::size_t kernel(std::span<T> out) const { return kernels::clamp_into(src, out, lo, hi); }
+
+    std::span<const T> src;
+    T lo, hi;
+};
+
+template <typename T>
+struct clamp_holder { T lo, hi; };
+
+template <typename T>
+clamp_holder<T> clamped(T lo, T hi) { return {lo, hi}; }
+
+// Found by ADL through clamp_holder. Contiguous sources of T get the bulk
+// range; everything else gets the element-wise range from ex_05.cpp.
+template <typename Range, typename T>
+auto operator|(const Range& r, const clamp_holder<T>& h) {
+    using It = decltype(boost::begin(r));
+    if constexpr (std::contiguous_iterator<It>
+                  && std::is_same_v<std::remove_cv_t<std::iter_value_t<It>>, T>) {
+        return contiguous_clamped_range<T>(std::to_address(boost::begin(r)),
+                                           std::size_t(boost::size(r)), h.lo, h.hi);
+    } else {
+        return boost::make_iterator_range(
+            clamp_iterator<It, T>(boost::begin(r), h.lo, h.hi),
+            clamp_iterator<It, T>(boost::end(r),   h.lo, h.hi));
+    }
+}
+
+} // namespace adaptors
+
+// ── Demo ──────────────────────────────────────────────────────────────────
+int main() {
+    std::vector<double> readings = {3, -2, 10, 25, 7, 8, -5};
+
+    auto cl = readings | adaptors::clamped(0.0, 15.0);          // contiguous path
+    auto pipe = cl | boost::adaptors::filtered([](double x) { return x > 0; });
+    for (double x : pipe) std::cout << x << ' ';
+    std::cout << "\nsize=" << boost::size(cl) << " *(begin+3)=" << *(boost::begin(cl) + 3) << '\n';
+
+    std::vector<double> bulk(readings.size());
+    cl.clamp_into(bulk);
+    bool ok = boost::equal(bulk, cl);
+
+    // The ring_buffer is not contiguous, so it keeps the element-wise range.
+    ring_buffer<double> rb(5);
+    for (double v : readings) rb.push_back(v);
+    auto rcl = rb | adaptors::clamped(0.0, 15.0);
+    static_assert(!std::is_same_v<decltype(rcl), adaptors::contiguous_clamped_range<double>>);
+    std::cout << "ring_buffer clamped: ";
+    for (double x : rcl) std::cout << x << ' ';
+    std::cout << '\n';
+
+    // Floats take the 8-wide kernel.
+    std::vector<float> f(1003);
+    for (std::size_t i = 0; i < f.size(); ++i) f[i] = float(i % 41) - 20.0f;
+    auto fcl = f | adaptors::clamped(-5.0f, 5.0f);
+    std::vector<float> fout(f.size());
+    fcl.clamp_into(fout);
+    ok &= boost::equal(fout, fcl);
+
+    // The dedicated kernels are the ones reached.
+#if defined(__AVX2__)
+    ok &= cl.lanes() == 4 && fcl.lanes() == 8;
+#elif defined(__SSE2__)
+    ok &= cl.lanes() == 2 && fcl.lanes() == 4;
+#else
+    ok &= cl.lanes() == 1 && fcl.lanes() == 1;
+#endif
+    std::cout << "kernel width: double " << cl.lanes() << ", float " << fcl.lanes() << '\n';
+
+    // ── Benchmark: 10M voltage readings ───────────────────────────────────
+    const std::size_t n = 10'000'000;
+    std::mt19937_64 gen(42);
+    std::normal_distribution<double> volts(2.5, 2.0);
+    std::vector<double> v(n);
+    for (double& x : v) x = volts(gen);
+
+    using clock = std::chrono::steady_clock;
+    auto best_ms = [](auto&& fn) {
+        double best = 1e300;
+        for (int r = 0; r < 5; ++r) {
+            auto t0 = clock::now();
+            fn();
+            best = std::min(best, std::chrono::duration<double, std::milli>(clock::now() - t0).count());
+        }
+        return best;
+    };
+
+    std::vector<double> a(n), b(n);
+    auto vcl = v | adaptors::clamped(0.0, 5.0);
+    double t_elem = best_ms([&] { boost::copy(vcl, a.begin()); });
+    double t_bulk = best_ms([&] { vcl.clamp_into(b); });
+    ok &= a == b;
+
+    // At 10M the pass is bound by memory bandwidth; a window that stays in
+    // L1/L2 shows the difference in compute.
+    const std::size_t w = 8192, reps = 1000;
+    auto window = boost::make_iterator_range(v.data(), v.data() + w);
+    auto wcl = window | adaptors::clamped(0.0, 5.0);
+    double t_elem_w = best_ms([&] { for (std::size_t r = 0; r < reps; ++r) boost::copy(wcl, a.begin()); });
+    double t_bulk_w = best_ms([&] { for (std::size_t r = 0; r < reps; ++r) wcl.clamp_into(b); });
+    ok &= std::equal(a.begin(), a.begin() + w, b.begin());
+
+    std::cout << '\n' << n << " readings, best of 5\n"
+              << "  boost::copy through clamp_iterator : " << t_elem << " ms\n"
+              << "  clamp_into                         : " << t_bulk << " ms\n"
+              << reps << " x " << w << "-reading window (cache-resident)\n"
+              << "  boost::copy through clamp_iterator : " << t_elem_w << " ms\n"
+              << "  clamp_into                         : " << t_bulk_w << " ms\n"
+              << (ok ? "results agree\n" : "RESULTS DIFFER\n");
+    return ok ? 0 : 1;
+}
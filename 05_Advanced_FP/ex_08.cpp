@@ -0,0 +1,273 @@
+// ============================================================================
+//  FLAT CURRYING: curry<N>
+//  One closure type per stage, every bound argument stored once in a tuple.
+// ============================================================================
+//
+// THE PROBLEM WITH NESTED LAMBDAS
+//   curryCalculatePrice() in ex_01.cpp, curry2/curry3 in try_03.cpp and the
+//   recursive curry of try_04.cpp all build stage k+1 as a NEW lambda that
+//   captures stage k's arguments again:
+//
+//       [quantity](int price) { return [quantity, price](int tax) { ... }; }
+//
+//   Applying n arguments therefore copies argument 1 n-1 times, argument 2
+//   n-2 times, ... -- O(n^2) copies -- and the recursive version also copies
+//   f into every layer and pads every captured char out to a pointer.
+//   try_04's Curried<F, Bound...> flattens the storage into a tuple, but its
+//   const& operator() rebuilds that tuple with tuple_cat on every step.
+//
+// curry<N>(f)
+//   curried<N, F, Bound...> holds f and a flat std::tuple<Bound...>:
+//     * a call that leaves the function short of N arguments returns the
+//       next stage, built IN PLACE from f, the bound arguments and the new
+//       ones -- no intermediate tuple
+//     * on an rvalue stage (the usual f(a)(b)(c) chain) everything is moved
+//       forward, so a full chain copies NOTHING; on an lvalue stage it is
+//       copied once, because that stage stays usable
+//     * the call that supplies the N-th argument is std::invoke(f, bound...,
+//       args...) straight away -- no last closure is built
+//     * several arguments may be supplied at once: curry<3>(f)(1, 2)(3)
+//   N is explicit, so generic lambdas and overload sets work; for a plain
+//   function pointer curry(f) reads N off the signature.
+//
+// Build & run:
+//   g++ -std=c++20 -O2 -Wall -Wextra -o flat_curry ex_08.cpp
+//   ./flat_curry
+// ============================================================================
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// =============================================================================
+//  curried<N, F, Bound...>
+// =============================================================================
+template <std::size_t N, class F, class... Bound>
+class curried {
+    static_assert(N > 0 && sizeof...(Bound) < N);
+
+    F f_;
+    [[no_unique_address]] std::tuple<Bound...> bound_;     // an empty tuple takes no space
+
+    template <std::size_t, class, class...> friend class curried;
+
+    // Self is this stage as const& (copy the state on) or && (move it on).
+    template <class Self, class... Args>
+    static constexpr decltype(auto) step(Self&& self, Args&&... args) {
+        static_assert(sizeof...(Args) > 0, "apply at least one argument");
+        static_assert(sizeof...(Bound) + sizeof...(Args) <= N, "too many arguments for curry<N>");
+        return std::apply(
+            [&](auto&&... b) -> decltype(auto) {
+                if constexpr (sizeof...(Bound) + sizeof...(Args) == N)
+                    return std::invoke(std::forward<Self>(self).f_,
+                                       std::forward<decltype(b)>(b)..., std::forward<Args>(args)...);
+                else
+                    return curried<N, F, Bound..., std::decay_t<Args>...>(
+                        std::in_place, std::forward<Self>(self).f_,
+                        std::forward<decltype(b)>(b)..., std::forward<Args>(args)...);
+            },
+            std::forward<Self>(self).bound_);
+    }
+
+public:
+    template <class G, class... B>
+    constexpr explicit curried(std::in_place_t, G&& f, B&&... b)
+        : f_(std::forward<G>(f)), bound_(std::forward<B>(b)...) {}
+
+    template <class... Args>
+    constexpr decltype(auto) operator()(Args&&... args) const& {
+        return step(*this, std::forward<Args>(args)...);
+    }
+    template <class... Args>
+    constexpr decltype(auto) operator()(Args&&... args) && {
+        return step(std::move(*this), std::forward<Args>(args)...);
+    }
+
+    static constexpr std::size_t remaining = N - sizeof...(Bound);
+};
+
+template <std::size_t N, class F>
+constexpr auto curry(F&& f) {
+    return curried<N, std::decay_t<F>>(std::in_place, std::forward<F>(f));
+}
+
+template <class R, class... Params>
+constexpr auto curry(R (*f)(Params...)) {
+    return curry<sizeof...(Params)>(f);
+}
+
+// =============================================================================
+//  The nested versions, for comparison
+// =============================================================================
+namespace nested {
+
+// try_04 step 3: each stage wraps the previous callable and one argument.
+template <class F>
+auto curry(F f) {
+    return [f = std::move(f)](auto a) {
+        if constexpr (std::is_invocable_v<const F&, decltype(a)&>) {
+            return f(a);
+        } else {
+            return nested::curry([f, a](auto&&... rest) -> decltype(f(a, std::forward<decltype(rest)>(rest)...)) {
+                return f(a, std::forward<decltype(rest)>(rest)...);
+            });
+        }
+    };
+}
+
+// try_04 step 4: a flat tuple, rebuilt by tuple_cat on every step.
+template <class F, class... Bound>
+class Curried {
+    F f_;
+    std::tuple<Bound...> bound_;
+
+public:
+    Curried(F f, std::tuple<Bound...> bound) : f_(std::move(f)), bound_(std::move(bound)) {}
+
+    template <class... Args>
+    auto operator()(Args&&... args) const& {
+        if constexpr (std::is_invocable_v<const F&, const Bound&..., Args...>) {
+            return std::apply([&](const auto&... b) { return std::invoke(f_, b..., std::forward<Args>(args)...); },
+                              bound_);
+        } else {
+            return Curried<F, Bound..., std::decay_t<Args>...>{
+                f_, std::tuple_cat(bound_, std::make_tuple(std::forward<Args>(args)...))};
+        }
+    }
+};
+
+template <class F>
+auto curried(F f) { return Curried<F>{std::move(f), {}}; }
+
+} // namespace nested
+
+// =============================================================================
+//  Instrumentation
+// =============================================================================
+struct counted {
+    static inline long copies = 0;
+    static inline long moves = 0;
+    static void reset() { copies = moves = 0; }
+
+    int v = 0;
+    explicit counted(int x) : v(x) {}
+    counted(const counted& o) : v(o.v) { ++copies; }
+    counted(counted&& o) noexcept : v(o.v) { ++moves; }
+};
+
+int sum8(counted a, counted b, counted c, counted d, counted e, counted f, counted g, counted h) {
+    return a.v + b.v + c.v + d.v + e.v + f.v + g.v + h.v;
+}
+
+int code8(char a, char b, char c, char d, char e, char f, char g, char h) {
+    return a + b + c + d + e + f + g + h;
+}
+
+std::size_t join8(const std::string& a, const std::string& b, const std::string& c, const std::string& d,
+                  const std::string& e, const std::string& f, const std::string& g, const std::string& h) {
+    return a.size() + b.size() + c.size() + d.size() + e.size() + f.size() + g.size() + h.size();
+}
+
+// Stage sizes after K chars are bound, nested (try_04 step 3) against flat.
+template <int K>
+void print_sizes(const auto& nested_stage, const auto& flat_stage) {
+    std::cout << "  " << K << " bound: nested " << sizeof(nested_stage) << " bytes, flat "
+              << sizeof(flat_stage) << " bytes\n";
+    if constexpr (K < 7) print_sizes<K + 1>(nested_stage('a'), flat_stage('a'));
+}
+
+int main() {
+    std::cout << "========== Correctness ==========\n\n";
+
+    auto price = curry<3>([](int quantity, int pricePerItem, int tax) { return quantity * pricePerItem + tax; });
+    auto quantity5 = price(5);
+    auto quantity5Price100 = quantity5(100);
+    assert(price(5)(100)(20) == 520 && quantity5Price100(10) == 510 && quantity5Price100(30) == 530);
+    assert(price(5, 100)(20) == 520 && price(5)(100, 20) == 520 && price(5, 100, 20) == 520);
+    static_assert(decltype(quantity5)::remaining == 2);
+
+    auto concat = curry(+[](std::string a, std::string b) { return a + b; });
+    assert(concat(std::string("foo::"))("bar") == "foo::bar");
+
+    int x = 1;
+    auto set = curry<2>([](int& r, int v) -> int& { return r = v; });
+    int& same = set(std::ref(x))(42);                  // reference results pass through
+    assert(&same == &x && x == 42);
+
+    constexpr auto add3 = curry<3>([](int a, int b, int c) { return a + b + c; });
+    static_assert(add3(1)(2)(3) == 6);
+
+    std::cout << "Curried price  : " << price(5)(100)(20) << '\n';
+    std::cout << "Reused stage   : " << quantity5Price100(10) << ", " << quantity5Price100(30) << "\n\n";
+
+    std::cout << "========== Copies for f(a1)...(a8) ==========\n\n";
+
+    auto fp = &sum8;
+    counted::reset();
+    int r_nested = nested::curry(fp)(counted{1})(counted{2})(counted{3})(counted{4})
+                                    (counted{5})(counted{6})(counted{7})(counted{8});
+    long nested_copies = counted::copies;
+    counted::reset();
+    int r_grouped = nested::curried(fp)(counted{1})(counted{2})(counted{3})(counted{4})
+                                       (counted{5})(counted{6})(counted{7})(counted{8});
+    long grouped_copies = counted::copies;
+    counted::reset();
+    int r_flat = curry(fp)(counted{1})(counted{2})(counted{3})(counted{4})
+                          (counted{5})(counted{6})(counted{7})(counted{8});
+    long flat_copies = counted::copies, flat_moves = counted::moves;
+    assert(r_nested == 36 && r_grouped == 36 && r_flat == 36);
+    assert(flat_copies == 0);
+
+    // An lvalue stage is copied once when it is applied, and stays usable.
+    auto half = curry(fp)(counted{1})(counted{2})(counted{3})(counted{4});
+    counted::reset();
+    int r_half = half(counted{5})(counted{6})(counted{7})(counted{8});
+    assert(r_half == 36 && counted::copies == 4 && half(counted{0}, counted{0}, counted{0}, counted{0}) == 10);
+
+    std::cout << "  nested lambdas (try_04 step 3) : " << nested_copies << " copies\n"
+              << "  Curried + tuple_cat (step 4)   : " << grouped_copies << " copies\n"
+              << "  curry<8>                       : " << flat_copies << " copies, " << flat_moves << " moves\n\n";
+
+    std::cout << "========== Stage sizes, char arguments ==========\n\n";
+
+    auto cp = &code8;
+    print_sizes<0>(nested::curry(cp), curry(cp));
+    static_assert(sizeof(curry(cp)('a')('b')('c')('d')('e')('f')('g')) == 16);   // pointer + 7 chars
+    std::cout << '\n';
+
+    std::cout << "========== Benchmark: 8 string arguments ==========\n\n";
+
+    const std::string arg(40, 'x');                     // past the small-string buffer
+    const int reps = 200'000;
+    auto sp = &join8;
+    using clock = std::chrono::steady_clock;
+    auto bench = [&](const char* label, auto&& chain) {
+        auto t0 = clock::now();
+        std::size_t acc = 0;
+        for (int i = 0; i < reps; ++i) acc += chain();
+        double ms = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+        std::cout << "  " << label << ms << " ms\n";
+        return acc;
+    };
+
+    // Each chain binds fresh strings, as a parser building calls would.
+    auto s = [&] { return std::string(arg); };
+    std::size_t b_nested = bench("nested lambdas      : ",
+        [&] { return nested::curry(sp)(s())(s())(s())(s())(s())(s())(s())(s()); });
+    std::size_t b_grouped = bench("Curried + tuple_cat : ",
+        [&] { return nested::curried(sp)(s())(s())(s())(s())(s())(s())(s())(s()); });
+    std::size_t b_flat = bench("curry<8>            : ",
+        [&] { return curry(sp)(s())(s())(s())(s())(s())(s())(s())(s()); });
+    std::size_t b_direct = bench("direct call         : ",
+        [&] { return join8(s(), s(), s(), s(), s(), s(), s(), s()); });
+
+    const bool ok = b_nested == b_grouped && b_grouped == b_flat && b_flat == b_direct;
+    std::cout << (ok ? "all versions agree\n" : "RESULTS DIFFER\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,257 @@
+// Build & run (needs C++20; -pthread for the once-only check):
+//   g++ -std=c++20 -O2 -pthread ex_09.cpp -o lazy_fused && ./lazy_fused
+//
+// Lazy from ex_03.cpp, rebuilt so that deferring a computation costs nothing extra.
+//
+// ex_03's Lazy<T> holds a std::function<T()>. Each transform copies that
+// std::function into a new closure and wraps it in another std::function, and
+// copying a std::function deep-copies every closure inside it, so a chain of n
+// transforms makes O(n^2) heap allocations (100 for the ten steps below). Each
+// call then goes through n indirect calls, force() runs the whole chain again
+// every time, and operator<< forces it once more just to print.
+//
+// Here the thunk's TYPE is the template parameter: Lazy<Thunk>.
+//   * transform(f) returns Lazy<then<Thunk, F>>, a struct holding the previous
+//     thunk and f by value. A chain is one nested object the compiler inlines
+//     into a single call: no std::function, no allocation.
+//   * force() runs the thunk at most once, under std::call_once, and keeps the
+//     result; later calls (and operator<<) return the stored value. Concurrent
+//     first calls block until the single evaluation finishes.
+//   * the result lives in a std::optional, so T needs no default constructor.
+//
+// Memoisation is per Lazy object. Intermediate stages of a fused chain are not
+// stored -- fusing is exactly what removes them -- so forcing both z and
+// z.transform(f) evaluates z's thunk twice, once for each object.
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// =====================================================================
+// Allocation counter: every operator new in the program goes through here.
+// =====================================================================
+static std::atomic<std::size_t> g_news{0};
+
+void* operator new(std::size_t n) {
+    ++g_news;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc{};
+}
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#pragma GCC diagnostic pop
+
+// =====================================================================
+// Lazy<Thunk> — a deferred, memoised value whose computation is a static type.
+// =====================================================================
+
+// The composed thunk: run Inner, then F. Both held by value.
+template <typename Inner, typename F>
+struct then {
+    Inner inner;
+    [[no_unique_address]] F f;           // captureless steps take no space
+    // By value: a step may return a reference into inner()'s temporary.
+    auto operator()() const { return std::invoke(f, inner()); }
+};
+
+template <typename Thunk>
+class Lazy {
+public:
+    using value_type = std::decay_t<std::invoke_result_t<const Thunk&>>;
+
+    explicit Lazy(Thunk thunk) : thunk_(std::move(thunk)) {}
+
+    // A copy takes the thunk and, if it is already there, the value. The
+    // once_flag itself cannot be copied; force() checks the value first.
+    Lazy(const Lazy& o) : thunk_(o.thunk_) {
+        if (o.ready_.load(std::memory_order_acquire)) store(*o.value_);
+    }
+    // The value is copied, not moved: o's once_flag may already have fired,
+    // so o must keep a valid value for its own force().
+    Lazy(Lazy&& o) noexcept(std::is_nothrow_move_constructible_v<Thunk>
+                            && std::is_nothrow_copy_constructible_v<value_type>)
+        : thunk_(std::move(o.thunk_)) {
+        if (o.ready_.load(std::memory_order_acquire)) store(*o.value_);
+    }
+    Lazy& operator=(const Lazy&) = delete;
+
+    const value_type& force() const {
+        if (ready_.load(std::memory_order_acquire)) return *value_;   // the common, memoised case
+        std::call_once(once_, [this] {
+            if (!ready_.load(std::memory_order_relaxed)) store(thunk_());
+        });
+        return *value_;
+    }
+
+    bool forced() const { return ready_.load(std::memory_order_acquire); }
+
+    template <typename F>
+    auto transform(F f) const& -> Lazy<then<Thunk, F>> {
+        return Lazy<then<Thunk, F>>{ then<Thunk, F>{ thunk_, std::move(f) } };
+    }
+    template <typename F>
+    auto transform(F f) && -> Lazy<then<Thunk, F>> {
+        return Lazy<then<Thunk, F>>{ then<Thunk, F>{ std::move(thunk_), std::move(f) } };
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const Lazy& l) {
+        return os << "Lazy(forced -> " << l.force() << ")";
+    }
+
+private:
+    template <typename U>
+    void store(U&& v) const {
+        value_.emplace(std::forward<U>(v));
+        ready_.store(true, std::memory_order_release);
+    }
+
+    Thunk thunk_;
+    mutable std::optional<value_type> value_;
+    mutable std::atomic<bool> ready_{false};
+    mutable std::once_flag once_;
+};
+
+// ex_03.cpp's version, kept for comparison.
+template <typename T>
+struct ErasedLazy {
+    std::function<T()> thunk;
+    T force() const { return thunk(); }
+
+    template <typename F>
+    auto transform(F f) const -> ErasedLazy<std::invoke_result_t<F, const T&>> {
+        auto inner = thunk;
+        return { [inner, f] { return f(inner()); } };
+    }
+};
+
+// A value with no default constructor, to show Lazy does not need one.
+struct Celsius {
+    explicit Celsius(double d) : deg(d) {}
+    double deg;
+    friend std::ostream& operator<<(std::ostream& os, const Celsius& c) { return os << c.deg << "C"; }
+};
+
+// Ten steps, applied to either kind of Lazy. Each step is a distinct lambda
+// type, as it would be in real code.
+template <typename L>
+auto ten_steps(const L& z) {
+    return z.transform([](int x) { return x + 1; }).transform([](int x) { return x * 3; })
+            .transform([](int x) { return x - 2; }).transform([](int x) { return x ^ 5; })
+            .transform([](int x) { return x + 7; }).transform([](int x) { return x * 5; })
+            .transform([](int x) { return x - 11; }).transform([](int x) { return x ^ 3; })
+            .transform([](int x) { return x + 13; }).transform([](int x) { return x % 1000003; });
+}
+
+int main() {
+    std::cout << std::boolalpha;
+
+    // -- Deferral and memoisation -----------------------------------------
+    int runs = 0;
+    Lazy z{ [&runs] { ++runs; return 21; } };
+    auto doubled = z.transform([](int x) { return x * 2; });
+    assert(runs == 0);                                           // nothing yet
+    std::cout << doubled << '\n';                                 // forces once
+    assert(doubled.force() == 42 && runs == 1);                   // second force: memoised
+    std::cout << "forced " << runs << " time(s) for three uses\n";
+
+    Lazy temp{ [] { return Celsius{21.5}; } };
+    std::cout << temp.transform([](const Celsius& c) { return Celsius{c.deg * 9 / 5 + 32}; }) << '\n';
+
+    // A forced Lazy that is moved from still answers with its value.
+    Lazy greeting{ [] { return std::string("hello, lazy world"); } };
+    greeting.force();
+    auto moved = std::move(greeting);
+    assert(moved.force() == "hello, lazy world" && greeting.force() == "hello, lazy world");
+
+    // A step returning a reference to its argument: the result is a copy.
+    auto same = Lazy{ [] { return std::string("kept past the temporary"); } }
+                    .transform([](const std::string& s) -> const std::string& { return s; });
+    assert(same.force() == "kept past the temporary");
+
+    // -- Functor laws, as in ex_03 -----------------------------------------
+    auto add_one   = [](int x) { return x + 1; };
+    auto times_two = [](int x) { return x * 2; };
+    auto fused     = [&](int x) { return times_two(add_one(x)); };
+    Lazy base{ [] { return 21; } };
+    std::cout << "identity law    : " << (base.transform([](int x) { return x; }).force() == base.force()) << '\n'
+              << "composition law : "
+              << (base.transform(add_one).transform(times_two).force() == base.transform(fused).force()) << '\n';
+
+    // -- Allocations -------------------------------------------------------
+    ErasedLazy<int> erased{ [] { return 7; } };
+    std::size_t n0 = g_news;
+    auto erased_chain = ten_steps(erased);
+    std::size_t erased_build = g_news - n0;
+
+    Lazy<int (*)()> fn_source{ +[] { return 7; } };
+    n0 = g_news;
+    auto lazy_chain = ten_steps(fn_source);
+    int lazy_value = lazy_chain.force();
+    std::size_t lazy_allocs = g_news - n0;
+    assert(lazy_value == erased_chain.force() && lazy_allocs == 0);
+
+    std::cout << "\n10-step chain\n"
+              << "  std::function Lazy (ex_03) : " << erased_build << " allocations, "
+              << sizeof(erased_chain) << " bytes\n"
+              << "  fused Lazy                 : " << lazy_allocs << " allocations, "
+              << sizeof(lazy_chain) << " bytes\n";
+
+    // -- Once only, under contention ---------------------------------------
+    std::atomic<int> evaluations{0};
+    Lazy shared{ [&evaluations] {
+        ++evaluations;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));   // a slow first use
+        return std::string("config loaded");
+    } };
+    std::vector<std::thread> readers;
+    std::atomic<int> agree{0};
+    for (int i = 0; i < 8; ++i)
+        readers.emplace_back([&] { agree += shared.force() == "config loaded"; });
+    for (auto& t : readers) t.join();
+    assert(evaluations == 1 && agree == 8);
+    std::cout << "8 threads forced one Lazy: evaluated " << evaluations << " time(s)\n";
+
+    // -- Forcing cost ------------------------------------------------------
+    using clock = std::chrono::steady_clock;
+    const int reps = 5'000'000;
+    long long acc = 0;
+    auto t0 = clock::now();
+    for (int i = 0; i < reps; ++i) acc += erased_chain.force();          // re-runs 11 indirect calls
+    double t_erased = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+    long long acc2 = 0;
+    t0 = clock::now();
+    for (int i = 0; i < reps; ++i) acc2 += lazy_chain.force();           // memoised
+    double t_memo = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+    long long acc3 = 0, acc4 = 0;
+    t0 = clock::now();
+    for (int i = 0; i < reps / 100; ++i) acc4 += ten_steps(erased).force();
+    double t_erased_fresh = std::chrono::duration<double, std::milli>(clock::now() - t0).count() * 100;
+    n0 = g_news;
+    t0 = clock::now();
+    for (int i = 0; i < reps; ++i) acc3 += ten_steps(Lazy<int (*)()>{ fn_source }).force();  // build + force
+    double t_fresh = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+    assert(g_news == n0);
+
+    const bool ok = acc == acc2 && acc2 == acc3 && acc4 * 100 == acc3;
+    std::cout << "\n" << reps << " forces of the 10-step chain\n"
+              << "  std::function Lazy, recomputed : " << t_erased << " ms\n"
+              << "  fused Lazy, memoised           : " << t_memo << " ms\n"
+              << "  std::function Lazy, built      : " << t_erased_fresh << " ms (extrapolated from " << reps / 100 << ")\n"
+              << "  fused Lazy, built and forced   : " << t_fresh << " ms\n"
+              << (ok ? "all agree\n" : "RESULTS DIFFER\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,424 @@
+// Build & run (needs C++20; -pthread for the parallel transform):
+//   g++ -std=c++20 -O2 -pthread ex_10.cpp -o flat_tree && ./flat_tree
+//
+// Tree from ex_03.cpp, stored flat.
+//
+// ex_03's Tree<T> is { T value; std::vector<Tree<T>> children; }: every node
+// with children owns its own heap block, a traversal chases a pointer per
+// level, and transform() recurses, rebuilding the vectors node by node.
+//
+// FlatTree<T> keeps the same shape in two parallel arrays, indexed by node:
+//   values[i]   the payload
+//   links[i]    parent, first child and next sibling, as 32-bit indices
+// The topology never depends on the values, so transform(f) is one linear pass
+// over `values` plus a copy of `links`; with a thread count it splits that pass
+// into chunks, one per thread. Traversal comes as ranges:
+//   depth_first()    preorder, a forward range; the iterator is one index and
+//                    walks the links, so it needs no stack
+//   breadth_first()  level order, an input range over a queue the range owns
+// Nodes are added with add_root / add_child and stay where they are put; the
+// order of `values` is the insertion order, not a traversal order.
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <random>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// =====================================================================
+// Allocation counter
+// =====================================================================
+static std::atomic<std::size_t> g_news{0};
+
+void* operator new(std::size_t n) {
+    ++g_news;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc{};
+}
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#pragma GCC diagnostic pop
+
+// =====================================================================
+// ex_03.cpp's Tree, for building and comparison
+// =====================================================================
+template <typename T>
+struct Tree {
+    T value;
+    std::vector<Tree<T>> children;
+
+    template <typename F>
+    auto transform(F f) const -> Tree<std::invoke_result_t<F, const T&>> {
+        Tree<std::invoke_result_t<F, const T&>> out{ f(value), {} };
+        out.children.reserve(children.size());
+        for (const auto& c : children)
+            out.children.push_back(c.transform(f));
+        return out;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const Tree& t) {
+        os << "Tree ";
+        t.stream_into(os);
+        return os;
+    }
+
+    void stream_into(std::ostream& os) const {
+        os << value;
+        if (!children.empty()) {
+            os << "(";
+            for (std::size_t i = 0; i < children.size(); ++i) {
+                children[i].stream_into(os);
+                if (i + 1 < children.size()) os << " ";
+            }
+            os << ")";
+        }
+    }
+};
+
+// =====================================================================
+// FlatTree<T>
+// =====================================================================
+using node_id = std::uint32_t;
+inline constexpr node_id no_node = ~node_id(0);
+
+struct node_links {
+    node_id parent       = no_node;
+    node_id first_child  = no_node;
+    node_id next_sibling = no_node;
+};
+
+template <typename T>
+class FlatTree {
+public:
+    FlatTree() = default;
+
+    // -- Building ------------------------------------------------------
+    node_id add_root(T value) {
+        assert(values_.empty());
+        return push(std::move(value), {});
+    }
+
+    // Children keep the order they were added in. last_child_ makes the
+    // append O(1) without a back pointer in every node; a transformed tree
+    // does not carry it, so the first add_child to one rebuilds it.
+    node_id add_child(node_id parent, T value) {
+        if (last_child_.size() != links_.size()) rebuild_last_child();
+        const node_id id = push(std::move(value), { parent, no_node, no_node });
+        if (links_[parent].first_child == no_node) links_[parent].first_child = id;
+        else                                        links_[last_child_[parent]].next_sibling = id;
+        last_child_[parent] = id;
+        return id;
+    }
+
+    void reserve(std::size_t n) {
+        values_.reserve(n);
+        links_.reserve(n);
+        last_child_.reserve(n);
+    }
+
+    // Flatten an ex_03 Tree; one pass, nodes in preorder.
+    static FlatTree from(const Tree<T>& t) {
+        FlatTree out;
+        out.add_root(t.value);
+        out.append_children(0, t);
+        return out;
+    }
+
+    // -- Access --------------------------------------------------------
+    std::size_t size() const { return values_.size(); }
+    bool empty() const { return values_.empty(); }
+    const T& operator[](node_id i) const { return values_[i]; }
+    const node_links& links(node_id i) const { return links_[i]; }
+    const std::vector<T>& values() const { return values_; }
+
+    // -- Functor -------------------------------------------------------
+    template <typename F>
+    auto transform(F f) const -> FlatTree<std::invoke_result_t<F, const T&>> {
+        FlatTree<std::invoke_result_t<F, const T&>> out;
+        out.values_.reserve(values_.size());
+        for (const T& v : values_) out.values_.push_back(f(v));
+        out.links_ = links_;
+        return out;
+    }
+
+    // The same pass split into chunks, one per thread; threads == 0 means one
+    // per hardware thread. The output is sized first, so U must be default
+    // constructible, and f must be safe to call concurrently.
+    template <typename F>
+        requires std::default_initializable<std::invoke_result_t<F, const T&>>
+    auto transform(F f, unsigned threads) const -> FlatTree<std::invoke_result_t<F, const T&>> {
+        constexpr std::size_t min_chunk = 16'384;
+        const std::size_t n = values_.size();
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = unsigned(std::min<std::size_t>(threads, n / min_chunk));
+        if (threads <= 1) return transform(std::move(f));
+
+        FlatTree<std::invoke_result_t<F, const T&>> out;
+        out.values_.resize(n);
+        auto run = [&](std::size_t lo, std::size_t hi) {
+            for (std::size_t i = lo; i < hi; ++i) out.values_[i] = f(values_[i]);
+        };
+        std::vector<std::thread> pool;
+        // Multiples of 64, so that when U is bool no two chunks share a word
+        // of the vector<bool>.
+        const std::size_t chunk = ((n + threads - 1) / threads + 63) / 64 * 64;
+        for (unsigned t = 1; t < threads; ++t)
+            pool.emplace_back(run, std::min(n, t * chunk), std::min(n, (t + 1) * chunk));
+        out.links_ = links_;                        // overlaps with the workers
+        run(0, std::min(n, chunk));
+        for (auto& th : pool) th.join();
+        return out;
+    }
+
+    // -- Traversal -----------------------------------------------------
+    class dfs_iterator {
+        const FlatTree* tree_ = nullptr;
+        node_id at_ = no_node;
+
+    public:
+        using value_type      = T;
+        using difference_type = std::ptrdiff_t;
+
+        dfs_iterator() = default;
+        dfs_iterator(const FlatTree* t, node_id at) : tree_(t), at_(at) {}
+
+        const T& operator*() const { return tree_->values_[at_]; }
+        node_id id() const { return at_; }
+
+        // Preorder successor: first child, else the next sibling of the
+        // nearest ancestor-or-self that has one.
+        dfs_iterator& operator++() {
+            const auto& l = tree_->links_;
+            if (l[at_].first_child != no_node) { at_ = l[at_].first_child; return *this; }
+            while (at_ != no_node && l[at_].next_sibling == no_node) at_ = l[at_].parent;
+            if (at_ != no_node) at_ = l[at_].next_sibling;
+            return *this;
+        }
+        dfs_iterator operator++(int) { auto t = *this; ++*this; return t; }
+        bool operator==(const dfs_iterator& o) const { return at_ == o.at_; }
+    };
+
+    class bfs_range : public std::ranges::view_interface<bfs_range> {
+        const FlatTree* tree_ = nullptr;
+        std::vector<node_id> queue_;                // a vector with a read head
+        std::size_t head_ = 0;
+
+    public:
+        class iterator {
+            bfs_range* r_ = nullptr;
+
+        public:
+            using value_type      = T;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+            explicit iterator(bfs_range* r) : r_(r) {}
+
+            const T& operator*() const { return r_->tree_->values_[r_->queue_[r_->head_]]; }
+            node_id id() const { return r_->queue_[r_->head_]; }
+
+            iterator& operator++() {
+                const auto& l = r_->tree_->links_;
+                for (node_id c = l[id()].first_child; c != no_node; c = l[c].next_sibling)
+                    r_->queue_.push_back(c);
+                ++r_->head_;
+                return *this;
+            }
+            void operator++(int) { ++*this; }
+            bool operator==(std::default_sentinel_t) const { return r_->head_ == r_->queue_.size(); }
+        };
+
+        explicit bfs_range(const FlatTree* t) : tree_(t) {
+            if (!t->empty()) queue_.push_back(0);
+        }
+        iterator begin() { return iterator(this); }
+        std::default_sentinel_t end() const { return {}; }
+    };
+
+    auto depth_first() const {
+        return std::ranges::subrange(dfs_iterator(this, empty() ? no_node : 0), dfs_iterator(this, no_node));
+    }
+    bfs_range breadth_first() const { return bfs_range(this); }
+
+    friend std::ostream& operator<<(std::ostream& os, const FlatTree& t) {
+        os << "Tree ";
+        if (!t.empty()) t.stream_into(os, 0);
+        return os;
+    }
+
+private:
+    template <typename> friend class FlatTree;
+
+    void rebuild_last_child() {
+        last_child_.assign(links_.size(), no_node);
+        for (node_id i = 0; i < links_.size(); ++i)
+            if (links_[i].parent != no_node && links_[i].next_sibling == no_node)
+                last_child_[links_[i].parent] = i;
+    }
+
+    node_id push(T value, node_links l) {
+        values_.push_back(std::move(value));
+        links_.push_back(l);
+        last_child_.push_back(no_node);
+        return node_id(values_.size() - 1);
+    }
+
+    void append_children(node_id parent, const Tree<T>& t) {
+        for (const auto& c : t.children) append_children(add_child(parent, c.value), c);
+    }
+
+    // Same text as Tree::stream_into, so the two can be compared.
+    void stream_into(std::ostream& os, node_id i) const {
+        os << values_[i];
+        if (links_[i].first_child == no_node) return;
+        os << "(";
+        for (node_id c = links_[i].first_child; c != no_node; c = links_[c].next_sibling) {
+            stream_into(os, c);
+            if (links_[c].next_sibling != no_node) os << " ";
+        }
+        os << ")";
+    }
+
+    std::vector<T> values_;
+    std::vector<node_links> links_;
+    std::vector<node_id> last_child_;               // building only; rebuilt on demand after transform
+};
+
+static_assert(std::forward_iterator<FlatTree<int>::dfs_iterator>);
+static_assert(std::ranges::forward_range<decltype(std::declval<const FlatTree<int>&>().depth_first())>);
+static_assert(std::ranges::input_range<FlatTree<int>::bfs_range>);
+
+template <typename T>
+std::string show(const T& x) {
+    std::ostringstream os;
+    os << x;
+    return os.str();
+}
+
+// A category hierarchy: depth up to 7, 0..12 children per node.
+Tree<int> make_hierarchy(std::mt19937& gen, int depth, int& next, int limit) {
+    Tree<int> t{ next++, {} };
+    std::uniform_int_distribution<int> fanout(depth < 3 ? 6 : 0, 12);
+    if (depth < 7)
+        for (int k = fanout(gen); k > 0 && next < limit; --k)
+            t.children.push_back(make_hierarchy(gen, depth + 1, next, limit));
+    return t;
+}
+
+int main() {
+    // -- Same shape, same text as ex_03 ------------------------------------
+    Tree<int> t{ 1, { Tree<int>{2, { Tree<int>{4, {}} }}, Tree<int>{3, {}} } };
+    auto flat = FlatTree<int>::from(t);
+    auto times_ten = [](int x) { return x * 10; };
+    std::cout << t << "  ->  " << t.transform(times_ten) << '\n'
+              << flat << "  ->  " << flat.transform(times_ten) << '\n';
+    assert(show(flat) == show(t) && show(flat.transform(times_ten)) == show(t.transform(times_ten)));
+
+    // A transformed tree can still grow: children append after existing ones.
+    auto grown = flat.transform(times_ten);
+    grown.add_child(0, 50);
+    grown.add_child(1, 60);
+    assert(show(grown) == "Tree 10(20(40 60) 30 50)");
+
+    std::cout << "depth-first  :";
+    for (int v : flat.depth_first()) std::cout << ' ' << v;
+    std::cout << "\nbreadth-first:";
+    for (int v : flat.breadth_first()) std::cout << ' ' << v;
+    std::cout << '\n';
+    assert((std::ranges::equal(flat.depth_first(), std::vector{1, 2, 4, 3})));
+    assert((std::ranges::equal(flat.breadth_first(), std::vector{1, 2, 3, 4})));
+
+    // Built directly, with a type change.
+    FlatTree<std::string> menu;
+    auto root = menu.add_root("root");
+    auto a = menu.add_child(root, "audio");
+    menu.add_child(root, "video");
+    menu.add_child(a, "codecs");
+    std::cout << menu << "  ->  " << menu.transform([](const std::string& s) { return s.size(); }) << "\n\n";
+
+    // -- A large hierarchy ------------------------------------------------
+    std::mt19937 gen(21);
+    int next = 0;
+    const int limit = 500'000;
+    std::size_t n0 = g_news;
+    Tree<int> big = make_hierarchy(gen, 0, next, limit);
+    std::size_t nested_allocs = g_news - n0;
+    n0 = g_news;
+    FlatTree<int> big_flat = FlatTree<int>::from(big);
+    std::size_t flat_allocs = g_news - n0;
+
+    auto f = [](int x) { return std::int64_t(x) * 3 + 1; };
+    using clock = std::chrono::steady_clock;
+    auto ms = [](auto t0) { return std::chrono::duration<double, std::milli>(clock::now() - t0).count(); };
+    const int passes = 10;
+
+    std::int64_t s_nested = 0, s_flat = 0, s_par = 0, s_dfs = 0, s_bfs = 0;
+    std::function<void(const Tree<std::int64_t>&)> sum_tree = [&](const Tree<std::int64_t>& n) {
+        s_nested += n.value;
+        for (const auto& c : n.children) sum_tree(c);
+    };
+
+    auto t0 = clock::now();
+    for (int p = 0; p < passes; ++p) sum_tree(big.transform(f));
+    double t_nested = ms(t0);
+
+    t0 = clock::now();
+    for (int p = 0; p < passes; ++p) {
+        auto out = big_flat.transform(f);
+        for (auto v : out.values()) s_flat += v;
+    }
+    double t_flat = ms(t0);
+
+    t0 = clock::now();
+    for (int p = 0; p < passes; ++p) {
+        auto out = big_flat.transform(f, 0);
+        for (auto v : out.values()) s_par += v;
+    }
+    double t_par = ms(t0);
+
+    t0 = clock::now();
+    for (int p = 0; p < passes; ++p)
+        for (int v : big_flat.depth_first()) s_dfs += f(v);
+    double t_dfs = ms(t0);
+
+    t0 = clock::now();
+    for (int p = 0; p < passes; ++p)
+        for (int v : big_flat.breadth_first()) s_bfs += f(v);
+    double t_bfs = ms(t0);
+
+    // Four chunks even on one core, so the threaded path is exercised; the
+    // bool transform writes a vector<bool>, shared words and all.
+    auto odd = [](const auto& v) { return v % 2 != 0; };
+    const bool chunks_agree = big_flat.transform(f, 4).values() == big_flat.transform(f).values()
+                           && big_flat.transform(odd, 3).values() == big_flat.transform(odd).values();
+
+    const bool ok = chunks_agree && s_nested == s_flat && s_flat == s_par && s_par == s_dfs && s_dfs == s_bfs
+                 && big_flat.size() == std::size_t(next);
+    std::cout << big_flat.size() << " nodes; building allocated " << nested_allocs << " blocks nested, "
+              << flat_allocs << " flat\n"
+              << passes << " passes of transform + visit every node\n"
+              << "  Tree (ex_03), recursive transform : " << t_nested << " ms\n"
+              << "  FlatTree, linear transform        : " << t_flat << " ms\n"
+              << "  FlatTree, parallel transform      : " << t_par << " ms  ("
+              << std::thread::hardware_concurrency() << " hardware threads)\n"
+              << "  FlatTree, depth_first() walk      : " << t_dfs << " ms\n"
+              << "  FlatTree, breadth_first() walk    : " << t_bfs << " ms\n"
+              << (ok ? "all traversals agree\n" : "RESULTS DIFFER\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,298 @@
+// The List applicative from ex_04.cpp, lazy, n-ary and parallel.
+// Build & run:  g++ -std=c++20 -O2 -pthread ex_11.cpp -o cartesian && ./cartesian
+//
+// combine(f, List<A>, List<B>) in ex_04.cpp (and apply2 for Many<T> in
+// try_11.cpp) builds all |A|x|B| results at once, with push_back and no
+// reserve. Combining three lists means nesting it, and the inner call builds
+// an |A|x|B| vector of intermediates only to throw it away. When the product
+// is a scenario space, the full vector may simply not fit.
+//
+// Here the product is a value you can index instead:
+//   cartesian(a, b, ...)         a random-access, sized view; element i is a
+//                                tuple of references (a[i0], b[i1], ...), with
+//                                the LAST list varying fastest, as ex_04 does
+//   combine_lazy(f, a, b, ...)   the same view with f applied to each tuple
+//   combine(f, a, b, ...)        n-ary and eager: sized once, then filled
+//   materialise(view, threads)   pre-sizes the output and fills it in tiles
+//                                of consecutive indices, which worker threads
+//                                claim one at a time
+// The result type is std::invoke_result_t on the element types, so nothing
+// is read from the lists to name it. A product too large for std::size_t is
+// a std::length_error, not a wrapped-around size.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <class T> using List = std::vector<T>;
+
+// ex_04's binary combine, kept for comparison.
+template <class F, class A, class B>
+auto combine_ex04(F f, List<A> a, List<B> b) {
+    std::vector<decltype(f(a.front(), b.front()))> out;
+    for (auto& x : a) for (auto& y : b) out.push_back(f(x, y));
+    return out;
+}
+
+// =====================================================================
+// cartesian_view — index i <-> (i0, i1, ..., in-1), last index fastest
+// =====================================================================
+template <std::ranges::random_access_range... Vs>
+    requires (sizeof...(Vs) > 0) && (std::ranges::view<Vs> && ...) && (std::ranges::sized_range<Vs> && ...)
+class cartesian_view : public std::ranges::view_interface<cartesian_view<Vs...>> {
+    static constexpr std::size_t N = sizeof...(Vs);
+
+    std::tuple<Vs...> bases_;
+    std::array<std::size_t, N> extent_{};
+    std::size_t size_ = 1;
+
+public:
+    using reference = std::tuple<std::ranges::range_reference_t<const Vs>...>;
+
+    cartesian_view() = default;
+    explicit cartesian_view(Vs... bases) : bases_(std::move(bases)...) {
+        std::size_t k = 0;
+        std::apply([&](const auto&... b) { ((extent_[k++] = std::ranges::size(b)), ...); }, bases_);
+        for (std::size_t e : extent_)
+            if (__builtin_mul_overflow(size_, e, &size_)) throw std::length_error("cartesian product too large");
+    }
+
+    std::size_t size() const { return size_; }
+    const std::array<std::size_t, N>& extents() const { return extent_; }
+
+    // The digits of i in the mixed radix given by the extents.
+    std::array<std::size_t, N> digits(std::size_t i) const {
+        std::array<std::size_t, N> d{};
+        if (size_ == 0) return d;                           // some extent is 0
+        for (std::size_t k = N; k-- > 0;) {
+            d[k] = i % extent_[k];
+            i /= extent_[k];
+        }
+        return d;
+    }
+
+    reference at(const std::array<std::size_t, N>& d) const {
+        return [&]<std::size_t... K>(std::index_sequence<K...>) {
+            return reference(std::ranges::begin(std::get<K>(bases_))[d[K]]...);
+        }(std::make_index_sequence<N>{});
+    }
+    reference operator[](std::size_t i) const { return at(digits(i)); }
+
+    // The iterator keeps the digits of its index next to the index: ++ and --
+    // step them like an odometer, so walking the view needs no division, and
+    // only a jump (+=, -=) works them out afresh.
+    class iterator {
+        const cartesian_view* v_ = nullptr;
+        std::ptrdiff_t i_ = 0;
+        std::array<std::size_t, N> d_{};
+
+    public:
+        using value_type        = reference;
+        using difference_type   = std::ptrdiff_t;
+        using iterator_concept  = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;   // reference is a prvalue tuple
+
+        iterator() = default;
+        iterator(const cartesian_view* v, std::ptrdiff_t i) : v_(v), i_(i), d_(v->digits(std::size_t(i))) {}
+
+        reference operator*() const { return v_->at(d_); }
+        reference operator[](difference_type k) const { return (*v_)[std::size_t(i_ + k)]; }
+
+        iterator& operator++() {
+            ++i_;
+            for (std::size_t k = N; k-- > 0;) {
+                if (++d_[k] < v_->extent_[k]) break;
+                d_[k] = 0;
+            }
+            return *this;
+        }
+        iterator operator++(int) { auto t = *this; ++*this; return t; }
+        iterator& operator--() {
+            --i_;
+            for (std::size_t k = N; k-- > 0;) {
+                if (d_[k]-- > 0) break;
+                d_[k] = v_->extent_[k] - 1;
+            }
+            return *this;
+        }
+        iterator operator--(int) { auto t = *this; --*this; return t; }
+        iterator& operator+=(difference_type k) { i_ += k; d_ = v_->digits(std::size_t(i_)); return *this; }
+        iterator& operator-=(difference_type k) { return *this += -k; }
+
+        friend iterator operator+(iterator it, difference_type k) { return it += k; }
+        friend iterator operator+(difference_type k, iterator it) { return it += k; }
+        friend iterator operator-(iterator it, difference_type k) { return it -= k; }
+        friend difference_type operator-(const iterator& a, const iterator& b) { return a.i_ - b.i_; }
+        friend bool operator==(const iterator& a, const iterator& b) { return a.i_ == b.i_; }
+        friend auto operator<=>(const iterator& a, const iterator& b) { return a.i_ <=> b.i_; }
+    };
+
+    iterator begin() const { return {this, 0}; }
+    iterator end() const { return {this, std::ptrdiff_t(size_)}; }
+};
+
+template <class... Rs>
+cartesian_view(Rs&&...) -> cartesian_view<std::views::all_t<Rs>...>;
+
+template <std::ranges::viewable_range... Rs>
+auto cartesian(Rs&&... rs) {
+    return cartesian_view(std::views::all(std::forward<Rs>(rs))...);
+}
+
+template <class F, std::ranges::viewable_range... Rs>
+auto combine_lazy(F f, Rs&&... rs) {
+    return cartesian(std::forward<Rs>(rs)...)
+         | std::views::transform([f = std::move(f)](const auto& t) { return std::apply(f, t); });
+}
+
+static_assert(std::ranges::random_access_range<cartesian_view<std::views::all_t<List<int>&>>>);
+static_assert(std::ranges::random_access_range<decltype(combine_lazy(std::plus<>{}, std::declval<List<int>&>(),
+                                                                     std::declval<List<int>&>()))>);
+
+// =====================================================================
+// Eager: n-ary combine and the tiled parallel materialise
+// =====================================================================
+
+template <class F, class... Ts>
+auto combine(F f, const List<Ts>&... lists) -> List<std::invoke_result_t<F&, const Ts&...>> {
+    auto v = cartesian(lists...);
+    List<std::invoke_result_t<F&, const Ts&...>> out;
+    out.reserve(v.size());
+    for (const auto& t : v) out.push_back(std::apply(f, t));
+    return out;
+}
+
+// threads == 0 means one per hardware thread. The output is sized up front,
+// so the result type must be default constructible, and f must be safe to
+// call concurrently.
+template <class F, class... Vs>
+auto materialise(F f, const cartesian_view<Vs...>& v, unsigned threads = 0) {
+    using R = decltype(std::apply(f, std::declval<typename cartesian_view<Vs...>::reference>()));
+    static_assert(std::is_default_constructible_v<R>);
+    constexpr std::size_t tile = 1 << 16;
+
+    const std::size_t n = v.size();
+    std::vector<R> out(n);
+    const std::size_t tiles = (n + tile - 1) / tile;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = unsigned(std::min<std::size_t>(threads, tiles));
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&] {
+        for (std::size_t t; (t = next.fetch_add(1, std::memory_order_relaxed)) < tiles;) {
+            const std::size_t lo = t * tile, hi = std::min(n, lo + tile);
+            R* dst = out.data() + lo;
+            for (auto it = v.begin() + std::ptrdiff_t(lo), e = v.begin() + std::ptrdiff_t(hi); it != e; ++it)
+                *dst++ = std::apply(f, *it);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned k = 1; k < threads; ++k) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+    return out;
+}
+
+int main() {
+    auto add = [](auto x, auto y) { return x + y; };
+
+    // -- ex_04 / try_11 results, lazily -------------------------------------
+    List<int> l1{1, 2}, l2{10, 20};
+    std::cout << "=== List (cartesian), lazy ===\nAfter :";
+    for (int x : combine_lazy(add, l1, l2)) std::cout << ' ' << x;
+    std::cout << '\n';
+    assert(std::ranges::equal(combine_lazy(add, l1, l2), combine(add, l1, l2)));
+
+    auto pairs = cartesian(l1, l2);
+    auto [x3, y3] = pairs[3];
+    assert(pairs.size() == 4 && x3 == 2 && y3 == 20);
+    assert((*(pairs.end() - 2) == std::tuple<const int&, const int&>(l1[1], l2[0])));
+
+    // Three lists, different types.
+    List<std::string> sizes{"S", "M"};
+    List<std::string> colours{"red", "blue", "green"};
+    List<int> qty{1, 5};
+    auto label = [](const std::string& s, const std::string& c, int q) { return std::to_string(q) + "x" + s + "-" + c; };
+    auto labels = combine(label, sizes, colours, qty);
+    std::cout << "3-ary :";
+    for (const auto& s : labels) std::cout << ' ' << s;
+    std::cout << '\n';
+    assert(labels.size() == 12 && labels[7] == "5xM-red");
+    assert(std::ranges::equal(labels, combine_lazy(label, sizes, colours, qty)));
+    assert(materialise(label, cartesian(sizes, colours, qty), 3) == labels);
+    auto backwards = combine_lazy(label, sizes, colours, qty) | std::views::reverse;
+    assert(std::ranges::equal(backwards, labels | std::views::reverse));
+
+    // A product that cannot be indexed is refused up front.
+    bool refused = false;
+    auto huge = std::views::iota(std::size_t(0), std::size_t(1) << 40);
+    try { cartesian(huge, huge); } catch (const std::length_error&) { refused = true; }
+    assert(refused);
+
+    // Empty lists give an empty product; nothing is read to find the type.
+    List<double> none;
+    assert(combine(add, none, l2).empty() && combine_lazy(add, l1, none).empty());
+
+    // -- Pricing scenarios ------------------------------------------------
+    List<double> price(2'000), discount(50), volume(100);
+    for (std::size_t i = 0; i < price.size(); ++i) price[i] = 10.0 + 0.25 * double(i);
+    for (std::size_t i = 0; i < discount.size(); ++i) discount[i] = 0.01 * double(i);
+    for (std::size_t i = 0; i < volume.size(); ++i) volume[i] = 100.0 * double(i + 1);
+    auto revenue = [](double p, double d, double v) { return p * (1 - d) * v; };
+
+    auto scenarios = cartesian(price, discount, volume);
+    std::cout << "\n" << scenarios.size() << " scenarios; the view is " << sizeof(scenarios)
+              << " bytes, materialised " << scenarios.size() * sizeof(double) / (1 << 20) << " MiB\n";
+
+    using clock = std::chrono::steady_clock;
+    auto ms = [](auto t0) { return std::chrono::duration<double, std::milli>(clock::now() - t0).count(); };
+
+    // ex_04: nest the binary combine; the inner call materialises |price| x |discount|.
+    auto t0 = clock::now();
+    auto nested = combine_ex04([](std::pair<double, double> pd, double v) { return pd.first * (1 - pd.second) * v; },
+                               combine_ex04([](double p, double d) { return std::pair{p, d}; }, price, discount),
+                               volume);
+    double t_nested = ms(t0);
+
+    t0 = clock::now();
+    auto eager = combine(revenue, price, discount, volume);
+    double t_eager = ms(t0);
+
+    t0 = clock::now();
+    auto tiled = materialise(revenue, scenarios);
+    double t_tiled = ms(t0);
+
+    // Streaming: the best scenario, never storing the product.
+    t0 = clock::now();
+    auto lazy = combine_lazy(revenue, price, discount, volume);
+    auto best = std::ranges::max_element(lazy);
+    double t_stream = ms(t0);
+    const std::size_t best_i = std::size_t(best - lazy.begin());
+    auto [bp, bd, bv] = scenarios[best_i];
+
+    const bool ok = nested == eager && eager == tiled && *best == *std::ranges::max_element(eager)
+                 && lazy[123'457] == eager[123'457];
+    std::cout << "  ex_04 combine, nested twice        : " << t_nested << " ms\n"
+              << "  n-ary combine, reserved            : " << t_eager << " ms\n"
+              << "  materialise, tiled                 : " << t_tiled << " ms ("
+              << std::thread::hardware_concurrency() << " hardware threads)\n"
+              << "  max over the lazy view, no storage : " << t_stream << " ms\n"
+              << "best: scenario " << best_i << " (price " << bp << ", discount " << bd << ", volume " << bv
+              << ") = " << *best << '\n'
+              << (ok ? "all versions agree\n" : "RESULTS DIFFER\n");
+    return ok ? 0 : 1;
+}
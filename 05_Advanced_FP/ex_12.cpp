@@ -0,0 +1,215 @@
+// A statically typed Reader: the applicative from ex_04.cpp without std::function.
+// Build & run:  g++ -std=c++20 -O2 ex_12.cpp -o reader_static && ./reader_static
+//
+// ex_04.cpp spells Reader<T> as std::function<T(Env)>, and ex_03.cpp's
+// Reader<R, T> wraps one too. Each combine / transform copies the inner
+// std::functions into a new closure and erases that into another
+// std::function, usually on the heap. A computation composed d levels deep
+// then costs d allocations to build and d indirect calls to run, none of
+// which the compiler can see through.
+//
+// Reader<Env, Run> keeps Run -- the composed callable -- as its type:
+//   pure<Env>(x)            ignores the environment
+//   ask<Env>()              the environment itself
+//   asks<Env>(f)            f applied to the environment
+//   r.transform(f)          f after r                  (Functor)
+//   combine(f, r1, ..., rn) f(r1(e), ..., rn(e))       (Applicative, any arity)
+// A composition is one nested struct, built without allocating, and running it
+// is ordinary inlinable code. When a uniform type really is needed -- to
+// store readers in a container, or to pass one across a library boundary --
+// r.erase() gives the std::function<T(const Env&)> explicitly, once.
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Allocation counter.
+static std::size_t g_news = 0;
+void* operator new(std::size_t n) {
+    ++g_news;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc{};
+}
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#pragma GCC diagnostic pop
+
+// =====================================================================
+// Reader<Env, Run>
+// =====================================================================
+template <class Env, class Run>
+struct Reader;
+
+template <class Env, class Run>
+Reader<Env, Run> make_reader(Run run) { return { std::move(run) }; }
+
+template <class Env, class Run>
+struct Reader {
+    Run run;
+
+    using value_type = std::decay_t<std::invoke_result_t<const Run&, const Env&>>;
+
+    decltype(auto) operator()(const Env& e) const { return std::invoke(run, e); }
+
+    template <class F>
+    auto transform(F f) const& {
+        return make_reader<Env>([r = run, f = std::move(f)](const Env& e) {
+            return std::invoke(f, std::invoke(r, e));
+        });
+    }
+    template <class F>
+    auto transform(F f) && {
+        return make_reader<Env>([r = std::move(run), f = std::move(f)](const Env& e) {
+            return std::invoke(f, std::invoke(r, e));
+        });
+    }
+
+    // The one place a std::function is made.
+    std::function<value_type(const Env&)> erase() const& { return run; }
+    std::function<value_type(const Env&)> erase() && { return std::move(run); }
+};
+
+template <class Env, class T>
+auto pure(T x) {
+    return make_reader<Env>([x = std::move(x)](const Env&) { return x; });
+}
+
+template <class Env>
+auto ask() {
+    return make_reader<Env>([](const Env& e) -> const Env& { return e; });
+}
+
+template <class Env, class F>
+auto asks(F f) {
+    return make_reader<Env>(std::move(f));
+}
+
+// Every reader sees the same environment.
+template <class F, class Env, class... Runs>
+auto combine(F f, Reader<Env, Runs>... rs) {
+    return make_reader<Env>([f = std::move(f), ... rs = std::move(rs)](const Env& e) {
+        return std::invoke(f, rs(e)...);
+    });
+}
+
+// =====================================================================
+// ex_04.cpp's Reader, kept for comparison
+// =====================================================================
+template <class Env, class T> using ErasedReader = std::function<T(Env)>;
+
+template <class F, class Env, class A, class B>
+auto combine(F f, ErasedReader<Env, A> a, ErasedReader<Env, B> b)
+    -> ErasedReader<Env, std::invoke_result_t<F&, A, B>> {
+    return [f, a, b](Env e) { return f(a(e), b(e)); };
+}
+
+// =====================================================================
+// A configuration-dependent computation, composed `depth` levels deep
+// =====================================================================
+struct Config {
+    std::uint32_t scale;
+    std::uint32_t offset;
+};
+
+// One level: fold the configuration into the accumulator.
+struct mix {
+    std::uint32_t k;
+    std::uint32_t operator()(std::uint32_t acc, const Config& c) const { return acc * c.scale + (c.offset ^ k); }
+};
+
+template <int D>
+auto build_static() {
+    if constexpr (D == 0) return pure<Config>(std::uint32_t(1));
+    else                  return combine(mix{ std::uint32_t(D) }, build_static<D - 1>(), ask<Config>());
+}
+
+ErasedReader<Config, std::uint32_t> build_erased(int depth) {
+    ErasedReader<Config, std::uint32_t> r = [](Config) { return std::uint32_t(1); };
+    ErasedReader<Config, Config> env = [](Config c) { return c; };
+    for (int d = 1; d <= depth; ++d) r = combine(mix{ std::uint32_t(d) }, r, env);
+    return r;
+}
+
+template <int D>
+void bench_depth() {
+    using clock = std::chrono::steady_clock;
+    const int evals = 2'000'000;
+    auto ns = [&](auto t0) {
+        return std::chrono::duration<double, std::nano>(clock::now() - t0).count() / evals;
+    };
+
+    std::size_t n0 = g_news;
+    auto s = build_static<D>();
+    std::size_t static_allocs = g_news - n0;
+    n0 = g_news;
+    auto e = build_erased(D);
+    std::size_t erased_allocs = g_news - n0;
+    auto se = s.erase();
+
+    std::uint32_t a1 = 0, a2 = 0, a3 = 0;
+    auto t0 = clock::now();
+    for (int i = 0; i < evals; ++i) a1 += s(Config{ 3, std::uint32_t(i) });
+    double t_static = ns(t0);
+    t0 = clock::now();
+    for (int i = 0; i < evals; ++i) a2 += e(Config{ 3, std::uint32_t(i) });
+    double t_erased = ns(t0);
+    t0 = clock::now();
+    for (int i = 0; i < evals; ++i) a3 += se(Config{ 3, std::uint32_t(i) });
+    double t_once = ns(t0);
+
+    if (a1 != a2 || a2 != a3) { std::cout << "RESULTS DIFFER at depth " << D << '\n'; std::exit(1); }
+    std::cout.width(6);  std::cout << D;
+    std::cout.width(10); std::cout << static_allocs;
+    std::cout.width(10); std::cout << erased_allocs;
+    std::cout.width(12); std::cout << t_static;
+    std::cout.width(12); std::cout << t_once;
+    std::cout.width(12); std::cout << t_erased << '\n';
+}
+
+int main() {
+    // -- ex_04's Reader example, statically typed ---------------------------
+    using Env = int;
+    auto ra = asks<Env>([](Env e) { return e + 1; });
+    auto rb = asks<Env>([](Env e) { return e * 10; });
+    auto add = [](auto x, auto y) { return x + y; };
+    std::cout << "=== Reader (function) ===\n"
+              << "Before: ra(5)=" << ra(5) << ", rb(5)=" << rb(5) << " (env=5)\n"
+              << "After : " << combine(add, ra, rb)(5) << "\n\n";
+    assert(combine(add, ra, rb)(5) == 56);
+
+    // Functor laws, as in ex_03.
+    auto len = asks<std::string>([](const std::string& s) { return int(s.size()); });
+    auto add_one = [](int x) { return x + 1; };
+    auto times_two = [](int x) { return x * 2; };
+    assert(len.transform([](int x) { return x; })("hello") == len("hello"));
+    assert(len.transform(add_one).transform(times_two)("hello") == len.transform([&](int x) { return times_two(add_one(x)); })("hello"));
+
+    // Any arity, pure, ask, and an explicit erase into a container.
+    auto greeting = combine([](const std::string& who, int n, const std::string& env) {
+                                return who + " x" + std::to_string(n) + " @" + env;
+                            },
+                            pure<std::string>(std::string("hi")), len, ask<std::string>());
+    assert(greeting("prod") == "hi x4 @prod");
+    std::vector<std::function<int(const std::string&)>> checks{ len.erase(), len.transform(add_one).erase() };
+    assert(checks[1]("abc") == 4);
+
+    // -- Depth 1..64 -------------------------------------------------------
+    std::cout << "evaluations of a reader composed d levels deep (ns each)\n"
+              << " depth   allocs:static erased      static  erase()'d   ex_04-style\n";
+    [&]<int... D>(std::integer_sequence<int, D...>) {
+        (bench_depth<D + 1>(), ...);
+    }(std::make_integer_sequence<int, 64>{});
+    std::cout << "all versions agree\n";
+    return 0;
+}
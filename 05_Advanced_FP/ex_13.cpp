@@ -0,0 +1,293 @@
+// A log monoid for Writer / Logged with O(1) append and merge.
+// Build & run:  g++ -std=c++20 -O2 ex_13.cpp -o log_rope && ./log_rope
+//
+// The Writer in ex_04.cpp merges logs with a.log + b.log, and Logged<T> in
+// try_14.cpp (like LoggedBox in try_12 / try_15) builds each step's log by
+// copying the previous vector and appending to it. Every bind copies the whole
+// history so far, so a chain of n binds copies O(n^2) entries.
+//
+// log_rope is the same monoid -- empty, and an associative merge -- stored as
+// an immutable tree shared between the logs that contain it:
+//   * a node is a message, a merge of two ropes, or a rope plus one message;
+//     append and merge each allocate ONE node and copy nothing else
+//   * nodes are shared through shared_ptr<const node>, so an old log stays
+//     valid and unchanged after something is appended to it (persistence)
+//   * a message is normally stored in its node. Text known to repeat can be
+//     interned instead (log_rope::interned, append_interned): it is stored
+//     once in a pool and nodes point at it, so a status line repeated 10k
+//     times costs 10k pointers, not 10k strings. The pool lives as long as
+//     the program, so it is only for a bounded set of texts
+//   * nothing is flattened until the log is read: lines() walks the tree
+//     once, left to right, with an explicit stack (a 10k-bind chain is a
+//     10k-deep tree), and the destructor unlinks deep chains the same way
+//
+// Writer<T> and Logged<T> below are ex_04's and try_14's shapes with the
+// log swapped for a log_rope.
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// =====================================================================
+// Message interning
+// =====================================================================
+// Elements of an unordered_set never move, so the pointers stay valid for
+// the life of the program. The pool only grows: intern fixed texts, not
+// messages built from data.
+class message_pool {
+    std::unordered_set<std::string> texts_;
+    std::mutex m_;
+
+public:
+    const std::string* intern(std::string_view text) {
+        std::lock_guard lock(m_);
+        return &*texts_.emplace(text).first;
+    }
+    std::size_t size() {
+        std::lock_guard lock(m_);
+        return texts_.size();
+    }
+
+    static message_pool& global() {
+        static message_pool pool;
+        return pool;
+    }
+};
+
+// =====================================================================
+// log_rope
+// =====================================================================
+class log_rope {
+    struct node;
+    using ptr = std::shared_ptr<const node>;
+
+    // Entries, in order: those of left, then those of right, then msg. msg
+    // points at own, or at a pooled string.
+    struct node {
+        ptr left, right;
+        std::string own;
+        const std::string* msg = nullptr;
+        std::size_t size = 0;
+
+        node(ptr l, ptr r, const std::string* m)
+            : left(std::move(l)), right(std::move(r)), msg(m),
+              size((left ? left->size : 0) + (right ? right->size : 0) + (m ? 1 : 0)) {}
+        node(ptr l, std::string_view text)
+            : left(std::move(l)), own(text), msg(&own), size((left ? left->size : 0) + 1) {}
+
+        // Releasing a 10k-deep chain recursively would use 10k stack frames.
+        // Children this node owns alone are moved onto a heap stack instead.
+        ~node() {
+            std::vector<ptr> pending;
+            auto take = [&](ptr& p) { if (p && p.use_count() == 1) pending.push_back(std::move(p)); };
+            take(left);
+            take(right);
+            while (!pending.empty()) {
+                ptr p = std::move(pending.back());
+                pending.pop_back();
+                auto& n = const_cast<node&>(*p);    // sole owner; nodes are created non-const
+                take(n.left);
+                take(n.right);
+            }
+        }
+    };
+
+    ptr root_;
+
+    explicit log_rope(ptr r) : root_(std::move(r)) {}
+
+public:
+    log_rope() = default;                                     // the monoid's empty
+    explicit log_rope(std::string_view message) : root_(std::make_shared<node>(nullptr, message)) {}
+
+    // For text that repeats: stored once in message_pool::global().
+    static log_rope interned(std::string_view message) {
+        return log_rope(std::make_shared<node>(nullptr, nullptr, message_pool::global().intern(message)));
+    }
+
+    std::size_t size() const { return root_ ? root_->size : 0; }
+    bool empty() const { return !root_; }
+
+    // The monoid operation. One node; both sides are shared, not copied.
+    friend log_rope operator+(const log_rope& a, const log_rope& b) {
+        if (!a.root_) return b;
+        if (!b.root_) return a;
+        return log_rope(std::make_shared<node>(a.root_, b.root_, nullptr));
+    }
+
+    // a + log_rope(message), in one node instead of two.
+    log_rope append(std::string_view message) const {
+        return log_rope(std::make_shared<node>(root_, message));
+    }
+    log_rope append_interned(std::string_view message) const {
+        return log_rope(std::make_shared<node>(root_, nullptr, message_pool::global().intern(message)));
+    }
+
+    // -- Reading: the only O(n) operations ------------------------------
+    template <class F>
+    void for_each(F f) const {
+        std::vector<std::pair<const node*, bool>> stack;     // (node, children already pushed)
+        if (root_) stack.push_back({ root_.get(), false });
+        while (!stack.empty()) {
+            auto [n, expanded] = stack.back();
+            stack.pop_back();
+            if (expanded) { f(std::string_view(*n->msg)); continue; }
+            if (n->msg) stack.push_back({ n, true });
+            if (n->right) stack.push_back({ n->right.get(), false });
+            if (n->left) stack.push_back({ n->left.get(), false });
+        }
+    }
+
+    std::vector<std::string_view> lines() const {
+        std::vector<std::string_view> out;
+        out.reserve(size());
+        for_each([&](std::string_view s) { out.push_back(s); });
+        return out;
+    }
+
+    std::string str(std::string_view sep = "") const {
+        std::string out;
+        bool first = true;
+        for_each([&](std::string_view s) {
+            if (!first) out += sep;
+            out += s;
+            first = false;
+        });
+        return out;
+    }
+};
+
+// =====================================================================
+// Writer (ex_04) and Logged (try_14) over the rope
+// =====================================================================
+template <class T> struct Writer { T value; log_rope log; };
+template <class T> Writer<T> pure_writer(T x) { return { std::move(x), {} }; }
+template <class F, class A, class B>
+auto combine(F f, const Writer<A>& a, const Writer<B>& b) {
+    return Writer<decltype(f(a.value, b.value))>{ f(a.value, b.value), a.log + b.log };
+}
+
+template <typename T>
+struct Logged {
+    T value;
+    log_rope log;
+
+    static Logged<T> of(T v, log_rope l = {}) { return Logged<T>{ std::move(v), std::move(l) }; }
+};
+
+template <typename T, typename F>
+auto and_then(const Logged<T>& w, F f) -> decltype(f(w.value)) {
+    auto next = f(w.value);
+    return decltype(next)::of(std::move(next.value), w.log + next.log);
+}
+
+// The versions being replaced, as the exercises build them.
+namespace copying {
+
+template <class T> struct Writer { T value; std::string log; };
+template <class F, class A, class B>
+auto combine(F f, const Writer<A>& a, const Writer<B>& b) {
+    return Writer<decltype(f(a.value, b.value))>{ f(a.value, b.value), a.log + b.log };
+}
+
+template <typename T>
+struct Logged {
+    T value;
+    std::vector<std::string> log;
+
+    static Logged<T> of(T v, std::vector<std::string> l = {}) { return Logged<T>{ std::move(v), std::move(l) }; }
+};
+
+template <typename T, typename F>
+auto and_then(const Logged<T>& w, F f) -> decltype(f(w.value)) {
+    auto next = f(w.value);
+    auto combined = w.log;
+    combined.insert(combined.end(), next.log.begin(), next.log.end());
+    return decltype(next)::of(next.value, combined);
+}
+
+} // namespace copying
+
+// A pricing step: one of a few status lines, as a real pipeline logs.
+constexpr std::string_view statuses[] = {
+    "validated order line; ", "applied regional tax table; ", "checked stock at primary warehouse; ",
+    "converted currency; ", "rounded to cents; ",
+};
+
+int main() {
+    // -- try_14's pipeline over the rope -----------------------------------
+    auto start    = [](int n) { return Logged<int>::of(n, log_rope("start with " + std::to_string(n))); };
+    auto double_it = [](int n) { return Logged<int>::of(n * 2, log_rope("doubled to " + std::to_string(n * 2))); };
+    auto add_ten  = [](int n) { return Logged<int>::of(n + 10, log_rope("added 10 to get " + std::to_string(n + 10))); };
+    auto result = and_then(and_then(start(5), double_it), add_ten);
+    std::cout << "value: " << result.value << "\nlog:\n";
+    for (auto line : result.log.lines()) std::cout << "  " << line << '\n';
+    assert(result.value == 20 && result.log.size() == 3 && result.log.lines()[1] == "doubled to 10");
+    assert(message_pool::global().size() == 0);         // messages built from data stay out of the pool
+
+    // ex_04's Writer example, and persistence: w1's log is untouched by the merge.
+    Writer<int> w1{ 2, log_rope("got2; ") }, w2{ 3, log_rope("got3; ") };
+    auto w = combine([](int x, int y) { return x + y; }, w1, w2);
+    assert(w.value == 5 && w.log.str() == "got2; got3; " && w1.log.str() == "got2; ");
+    assert((log_rope() + w.log).str() == w.log.str() && (w.log + log_rope()).str() == w.log.str());
+    auto abc = (log_rope("a") + log_rope("b")) + log_rope("c");
+    assert(abc.str() == (log_rope("a") + (log_rope("b") + log_rope("c"))).str());    // associative
+
+    // A million appends: built, read and freed without deep recursion.
+    {
+        log_rope deep;
+        for (int i = 0; i < 1'000'000; ++i) deep = deep.append_interned("tick");
+        assert(deep.size() == 1'000'000 && deep.lines().back() == "tick");
+    }
+
+    // -- 10k binds ---------------------------------------------------------
+    const int binds = 10'000;
+    using clock = std::chrono::steady_clock;
+    auto ms = [](auto t0) { return std::chrono::duration<double, std::milli>(clock::now() - t0).count(); };
+
+    auto t0 = clock::now();
+    copying::Logged<int> cv{ 0, {} };
+    for (int i = 0; i < binds; ++i)
+        cv = copying::and_then(cv, [&](int x) {
+            return copying::Logged<int>::of(x + 1, { std::string(statuses[i % 5]) });
+        });
+    double t_vector = ms(t0);
+
+    t0 = clock::now();
+    copying::Writer<int> cw{ 0, "" };
+    for (int i = 0; i < binds; ++i)
+        cw = copying::combine([](int x, int y) { return x + y; }, cw, copying::Writer<int>{ 1, std::string(statuses[i % 5]) });
+    double t_string = ms(t0);
+
+    t0 = clock::now();
+    Logged<int> rv{ 0, {} };
+    for (int i = 0; i < binds; ++i)
+        rv = and_then(rv, [&](int x) { return Logged<int>::of(x + 1, log_rope::interned(statuses[i % 5])); });
+    double t_rope = ms(t0);
+
+    t0 = clock::now();
+    std::string flat = rv.log.str();
+    double t_read = ms(t0);
+
+    std::string expected;
+    for (const auto& s : cv.log) expected += s;
+    const bool ok = rv.value == binds && cv.value == binds && flat == expected && flat == cw.log
+                 && rv.log.size() == std::size_t(binds);
+
+    std::cout << "\n" << binds << " binds, one status line each (" << flat.size() << " bytes of log)\n"
+              << "  Logged, vector<string> copied per bind (try_14) : " << t_vector << " ms\n"
+              << "  Writer, a.log + b.log (ex_04)                   : " << t_string << " ms\n"
+              << "  Logged over log_rope                            : " << t_rope << " ms\n"
+              << "  reading the rope back as one string             : " << t_read << " ms\n"
+              << "  distinct messages interned                      : " << message_pool::global().size() << '\n'
+              << (ok ? "all logs agree\n" : "LOGS DIFFER\n");
+    return ok ? 0 : 1;
+}
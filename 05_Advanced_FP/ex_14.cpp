@@ -0,0 +1,398 @@
+// Validation (Val) from ex_04.cpp: n-ary, by forwarding reference, errors in an arena.
+// Build & run:  g++ -std=c++20 -O2 ex_14.cpp -o validation && ./validation
+//
+// ex_04's combine(f, Val<A>, Val<B>) takes both boxes by value, copies both
+// error vectors (strings and all) into a fresh one, and only handles two
+// boxes, so four fields mean three nested combines and three rounds of
+// copying. fail<T> also builds a placeholder T{}, so T must be default
+// constructible.
+//
+// Here:
+//   * error_arena is one block of memory per request (a pmr monotonic buffer,
+//     optionally over a caller's stack buffer). An error is a node in it: the
+//     message text plus a next pointer.
+//   * error_list is a singly linked list of those nodes, with head and tail,
+//     so joining two lists is one pointer write.
+//   * Val<T> holds std::optional<T> and an error_list; a failed Val has no T
+//     at all, so T needs no default constructor.
+//   * combine(f, v1, ..., vn) takes every Val by forwarding reference. With
+//     no errors it calls f once, moving values out of rvalue boxes. Otherwise
+//     it splices the error lists in argument order: an rvalue's list is taken
+//     as it is, an lvalue's (which must stay intact) is copied within the
+//     arena. Either way the combine itself touches the heap at most once,
+//     when the arena grows.
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Allocation counter.
+static std::size_t g_news = 0;
+void* operator new(std::size_t n) {
+    ++g_news;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc{};
+}
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#pragma GCC diagnostic pop
+
+// =====================================================================
+// Errors: nodes in an arena, lists that splice in O(1)
+// =====================================================================
+struct error_node {
+    std::string_view message;
+    error_node* next;
+};
+
+class error_list {
+    error_node* head_ = nullptr;
+    error_node* tail_ = nullptr;
+    std::size_t size_ = 0;
+
+    friend class error_arena;
+
+public:
+    // Move-only: a list owns its nodes, since splice() writes to its tail.
+    // A second list over the same errors is made with error_arena::copy.
+    error_list() = default;
+    error_list(const error_list&) = delete;
+    error_list& operator=(const error_list&) = delete;
+    error_list(error_list&& o) noexcept : head_(o.head_), tail_(o.tail_), size_(o.size_) { o.clear(); }
+    error_list& operator=(error_list&& o) noexcept {
+        head_ = o.head_; tail_ = o.tail_; size_ = o.size_;
+        o.clear();
+        return *this;
+    }
+
+    bool empty() const { return size_ == 0; }
+    std::size_t size() const { return size_; }
+
+    // Append o's nodes after ours; o is left empty.
+    void splice(error_list&& o) {
+        if (o.empty()) return;
+        if (empty()) head_ = o.head_;
+        else         tail_->next = o.head_;
+        tail_ = o.tail_;
+        size_ += o.size_;
+        o.clear();
+    }
+
+    class iterator {
+        const error_node* n_ = nullptr;
+
+    public:
+        using value_type      = std::string_view;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(const error_node* n) : n_(n) {}
+        std::string_view operator*() const { return n_->message; }
+        iterator& operator++() { n_ = n_->next; return *this; }
+        iterator operator++(int) { auto t = *this; n_ = n_->next; return t; }
+        bool operator==(const iterator&) const = default;
+    };
+    iterator begin() const { return iterator(head_); }
+    iterator end() const { return iterator(nullptr); }
+
+private:
+    void clear() { head_ = tail_ = nullptr; size_ = 0; }
+};
+static_assert(std::forward_iterator<error_list::iterator>);
+
+class error_arena {
+    std::pmr::monotonic_buffer_resource mem_;
+
+    error_node* node(std::string_view message) {
+        std::pmr::polymorphic_allocator<char> alloc(&mem_);
+        char* text = alloc.allocate(message.size());
+        std::copy(message.begin(), message.end(), text);
+        auto* n = std::pmr::polymorphic_allocator<error_node>(&mem_).allocate(1);
+        return new (n) error_node{ std::string_view(text, message.size()), nullptr };
+    }
+
+public:
+    explicit error_arena(std::size_t initial = 4096) : mem_(initial) {}
+    error_arena(void* buffer, std::size_t bytes) : mem_(buffer, bytes) {}
+    error_arena(const error_arena&) = delete;
+
+    error_list make(std::string_view message) {
+        error_list l;
+        l.head_ = l.tail_ = node(message);
+        l.size_ = 1;
+        return l;
+    }
+
+    // A copy of l's nodes (the text is shared; it never changes).
+    error_list copy(const error_list& l) {
+        error_list out;
+        for (const error_node* n = l.head_; out.size_ < l.size_; n = n->next) {
+            error_node* c = std::pmr::polymorphic_allocator<error_node>(&mem_).allocate(1);
+            new (c) error_node{ n->message, nullptr };
+            if (out.empty()) out.head_ = c;
+            else             out.tail_->next = c;
+            out.tail_ = c;
+            ++out.size_;
+        }
+        return out;
+    }
+};
+
+// =====================================================================
+// Val<T>
+// =====================================================================
+template <class T>
+class Val {
+    std::optional<T> value_;
+    error_list errors_;
+    error_arena* arena_ = nullptr;
+
+    template <class> friend class Val;
+    template <class F, class... Vs> friend auto combine(F&& f, Vs&&... vs);
+
+    // Neither ok nor failed; only ok(), fail() and combine() start from it.
+    Val() = default;
+
+public:
+    using value_type = T;
+
+    // Copies get their own nodes, in the arena the errors came from.
+    Val(const Val& o)
+        : value_(o.value_), errors_(o.arena_ ? o.arena_->copy(o.errors_) : error_list{}), arena_(o.arena_) {}
+    Val(Val&&) = default;
+    Val& operator=(const Val& o) { if (this != &o) *this = Val(o); return *this; }
+    Val& operator=(Val&&) = default;
+
+    static Val ok(T v) { Val r; r.value_.emplace(std::move(v)); return r; }
+    static Val fail(error_arena& a, std::string_view message) {
+        Val r;
+        r.errors_ = a.make(message);
+        r.arena_ = &a;
+        return r;
+    }
+
+    bool is_ok() const { return value_.has_value(); }
+    const T& value() const& { return *value_; }
+    T&& value() && { return *std::move(value_); }
+    const error_list& errors() const { return errors_; }
+};
+
+template <class T> Val<std::decay_t<T>> pure_val(T&& x) { return Val<std::decay_t<T>>::ok(std::forward<T>(x)); }
+template <class T> Val<T> fail(error_arena& a, std::string_view message) { return Val<T>::fail(a, message); }
+
+template <class> inline constexpr bool is_val = false;
+template <class T> inline constexpr bool is_val<Val<T>> = true;
+
+template <class F, class... Vs>
+auto combine(F&& f, Vs&&... vs) {
+    static_assert((is_val<std::remove_cvref_t<Vs>> && ...), "combine takes Val<T> boxes");
+    static_assert(sizeof...(Vs) > 0);
+    using R = std::invoke_result_t<F, decltype(*std::forward<Vs>(vs).value_)...>;
+
+    if ((vs.is_ok() && ...))
+        return Val<R>::ok(std::invoke(std::forward<F>(f), *std::forward<Vs>(vs).value_...));
+
+    Val<R> out;
+    auto take = [&](auto&& v) {
+        if (v.errors_.empty()) return;
+        if (!out.arena_) out.arena_ = v.arena_;
+        if constexpr (std::is_rvalue_reference_v<decltype(v)> && !std::is_const_v<std::remove_reference_t<decltype(v)>>)
+            out.errors_.splice(std::move(v.errors_));
+        else
+            out.errors_.splice(v.arena_->copy(v.errors_));
+    };
+    (take(std::forward<Vs>(vs)), ...);
+    return out;
+}
+
+// =====================================================================
+// ex_04.cpp's Val, kept for comparison
+// =====================================================================
+namespace ex04 {
+template <class T> struct Val {
+    std::vector<std::string> errors; T value;
+    bool ok() const { return errors.empty(); }
+};
+template <class T> Val<T> pure_val(T x)     { return { {}, x }; }
+template <class T> Val<T> fail(std::string m) { return { { std::move(m) }, T{} }; }
+template <class F, class A, class B>
+auto combine(F f, Val<A> a, Val<B> b) {
+    using R = decltype(f(a.value, b.value));
+    std::vector<std::string> all = a.errors;
+    all.insert(all.end(), b.errors.begin(), b.errors.end());
+    if (all.empty()) return Val<R>{ {}, f(a.value, b.value) };
+    return Val<R>{ all, R{} };
+}
+} // namespace ex04
+
+// =====================================================================
+// A form: four fields per row, validated and combined into a Customer
+// =====================================================================
+struct Email {                                   // no default constructor
+    explicit Email(std::string a) : address(std::move(a)) {}
+    std::string address;
+};
+struct Customer {
+    std::string name;
+    int age;
+    Email email;
+    std::string zip;
+};
+
+struct Row {
+    std::string name;
+    int age;
+    std::string email;
+    std::string zip;
+};
+
+Val<std::string> check_name(error_arena& a, const std::string& s) {
+    return s.empty() ? fail<std::string>(a, "name: must not be empty") : pure_val(s);
+}
+Val<int> check_age(error_arena& a, int n) {
+    return n < 0 || n > 150 ? fail<int>(a, "age: out of range") : pure_val(n);
+}
+Val<Email> check_email(error_arena& a, const std::string& s) {
+    return s.find('@') == std::string::npos ? fail<Email>(a, "email: missing @") : pure_val(Email{ s });
+}
+Val<std::string> check_zip(error_arena& a, const std::string& s) {
+    return s.size() != 5 ? fail<std::string>(a, "zip: must have 5 digits") : pure_val(s);
+}
+
+Val<Customer> validate(error_arena& a, const Row& r) {
+    return combine([](std::string n, int age, Email e, std::string z) {
+                       return Customer{ std::move(n), age, std::move(e), std::move(z) };
+                   },
+                   check_name(a, r.name), check_age(a, r.age), check_email(a, r.email), check_zip(a, r.zip));
+}
+
+namespace ex04 {
+struct Customer { std::string name; int age; std::string email; std::string zip; };
+Val<std::string> check_name(const std::string& s) { return s.empty() ? fail<std::string>("name: must not be empty") : pure_val(s); }
+Val<int> check_age(int n) { return n < 0 || n > 150 ? fail<int>("age: out of range") : pure_val(n); }
+Val<std::string> check_email(const std::string& s) { return s.find('@') == std::string::npos ? fail<std::string>("email: missing @") : pure_val(s); }
+Val<std::string> check_zip(const std::string& s) { return s.size() != 5 ? fail<std::string>("zip: must have 5 digits") : pure_val(s); }
+
+// Binary only: nest three combines through pairs.
+Val<Customer> validate(const ::Row& r) {
+    using NA = std::pair<std::string, int>;
+    using EZ = std::pair<std::string, std::string>;
+    auto na = combine([](std::string n, int a) { return NA{ n, a }; }, check_name(r.name), check_age(r.age));
+    auto ez = combine([](std::string e, std::string z) { return EZ{ e, z }; }, check_email(r.email), check_zip(r.zip));
+    return combine([](NA p, EZ q) { return Customer{ p.first, p.second, q.first, q.second }; }, na, ez);
+}
+} // namespace ex04
+
+int main() {
+    // -- Small cases ---------------------------------------------------------
+    error_arena arena;
+    auto add = [](auto x, auto y) { return x + y; };
+    auto ok = combine(add, pure_val(2), pure_val(3));
+    assert(ok.is_ok() && ok.value() == 5);
+
+    auto bad = combine(add, fail<int>(arena, "name empty"), fail<int>(arena, "age negative"));
+    std::cout << "=== Validation (Val) ===\nerrors=";
+    for (auto e : bad.errors()) std::cout << " [" << e << ']';
+    std::cout << '\n';
+    assert(!bad.is_ok() && bad.errors().size() == 2);
+
+    // An lvalue keeps its errors; an rvalue gives them up.
+    auto f1 = fail<Email>(arena, "email: missing @");
+    auto both = combine([](const Email& e, int) { return e.address.size(); }, f1, fail<int>(arena, "age: out of range"));
+    assert(both.errors().size() == 2 && f1.errors().size() == 1 && *f1.errors().begin() == "email: missing @");
+    auto three = combine([](std::size_t a, std::size_t b, std::size_t c) { return a + b + c; },
+                         std::move(both), pure_val(std::size_t(1)), fail<std::size_t>(arena, "third"));
+    assert(three.errors().size() == 3);
+    std::vector<std::string_view> msgs(three.errors().begin(), three.errors().end());
+    assert(msgs[0] == "email: missing @" && msgs[2] == "third");
+
+    // Copies own their errors: splicing one leaves the other intact.
+    {
+        auto x = fail<int>(arena, "X");
+        auto y = x;
+        auto twice = combine(add, std::move(x), std::move(y));
+        assert(std::distance(twice.errors().begin(), twice.errors().end()) == 2);
+
+        auto p = fail<int>(arena, "P");
+        auto q = p;
+        auto r1 = combine(add, std::move(p), fail<int>(arena, "first"));
+        auto r2 = combine(add, std::move(q), fail<int>(arena, "second"));
+        std::vector<std::string_view> e1(r1.errors().begin(), r1.errors().end());
+        std::vector<std::string_view> e2(r2.errors().begin(), r2.errors().end());
+        assert((e1 == std::vector<std::string_view>{ "P", "first" }));
+        assert((e2 == std::vector<std::string_view>{ "P", "second" }));
+    }
+
+    // Splicing rvalues touches no memory at all.
+    {
+        auto a = fail<int>(arena, "a"), b = fail<int>(arena, "b"), c = fail<int>(arena, "c"), d = fail<int>(arena, "d");
+        std::size_t n0 = g_news;
+        auto all = combine([](int, int, int, int) { return 0; }, std::move(a), std::move(b), std::move(c), std::move(d));
+        assert(g_news == n0 && all.errors().size() == 4 && a.errors().empty());
+    }
+
+    Row good{ "Ada", 36, "ada@example.com", "12345" };
+    auto c = validate(arena, good);
+    assert(c.is_ok() && c.value().email.address == "ada@example.com");
+    auto r = validate(arena, Row{ "", 200, "nope", "1" });
+    assert(r.errors().size() == 4);
+
+    // -- A request: thousands of field validators ---------------------------
+    const int rows_per_request = 1000, requests = 200;
+    std::vector<Row> rows;
+    for (int i = 0; i < rows_per_request; ++i)
+        rows.push_back(Row{ i % 7 == 0 ? "" : "customer-" + std::to_string(i), i % 11 == 0 ? -1 : 20 + i % 50,
+                            i % 5 == 0 ? "missing-at-sign.example.com" : "user" + std::to_string(i) + "@example.com",
+                            i % 13 == 0 ? "123" : "54321" });
+
+    using clock = std::chrono::steady_clock;
+    auto ms = [](auto t0) { return std::chrono::duration<double, std::milli>(clock::now() - t0).count(); };
+
+    std::size_t n0 = g_news, errors_old = 0, valid_old = 0;
+    auto t0 = clock::now();
+    for (int q = 0; q < requests; ++q)
+        for (const auto& row : rows) {
+            auto v = ex04::validate(row);
+            errors_old += v.errors.size();
+            valid_old += v.ok();
+        }
+    double t_old = ms(t0);
+    double allocs_old = double(g_news - n0) / requests;
+
+    n0 = g_news;
+    std::size_t errors_new = 0, valid_new = 0;
+    t0 = clock::now();
+    for (int q = 0; q < requests; ++q) {
+        alignas(std::max_align_t) static std::byte buffer[64 * 1024];
+        error_arena request_arena(buffer, sizeof buffer);          // one per request
+        for (const auto& row : rows) {
+            auto v = validate(request_arena, row);
+            errors_new += v.errors().size();
+            valid_new += v.is_ok();
+        }
+    }
+    double t_new = ms(t0);
+    double allocs_new = double(g_news - n0) / requests;
+
+    const bool same = errors_old == errors_new && valid_old == valid_new;
+    std::cout << "\n" << requests << " requests x " << rows_per_request << " rows x 4 fields ("
+              << errors_new / requests << " errors per request)\n"
+              << "  ex_04 Val, nested binary combine : " << t_old << " ms, " << allocs_old << " allocations/request\n"
+              << "  arena Val, one 4-ary combine     : " << t_new << " ms, " << allocs_new << " allocations/request\n"
+              << (same ? "both report the same errors\n" : "RESULTS DIFFER\n");
+    return same ? 0 : 1;
+}